@@ -0,0 +1,870 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "pm1d_protocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+
+#include <utilities/raii/exception_engine.hpp>
+
+/**
+ * pm1d 客户端
+ *
+ * 与 pm1_sdk_native 签名相同，所有操作转发给本地守护进程；
+ * 错误信息保存在本进程的错误管理器中
+ */
+
+using namespace autolabor::pm1;
+using namespace autolabor::pm1::daemon;
+
+using handler_t  = native::handler_t;
+using error_code = autolabor::pm1::error_code;
+
+constexpr auto
+    daemon_unavailable = "pm1d is not available",
+    not_connected      = "not connected to pm1d";
+
+// region task resources
+
+std::atomic<handler_t> task_id(0);
+
+// 错误信息被之后的操作覆盖时报告错误，不会误报为成功
+autolabor::exception_engine<handler_t, error_code> exceptions(error_code::other, "error information evicted"); // NOLINT(cert-err58-cpp)
+
+// endregion
+// region connections
+
+std::mutex       connections_mutex;
+std::vector<int> idle_connections;
+std::string      socket_path,
+                 connected_port;
+
+/** 建立一个新连接 */
+int connect_daemon() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    {
+        std::lock_guard<decltype(connections_mutex)> lock(connections_mutex);
+        if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path))
+            return -1;
+        std::strcpy(address.sun_path, socket_path.c_str());
+    }
+    const auto fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/** 发送请求并等待应答，失败返回 false */
+bool exchange(int fd, const request_t &request, response_t &response) {
+    return send_message(fd, request, MSG_NOSIGNAL) && receive_message(fd, response);
+}
+
+/** 借用空闲连接执行一次请求 */
+bool call(const request_t &request, response_t &response) {
+    int fd = -1;
+    {
+        std::lock_guard<decltype(connections_mutex)> lock(connections_mutex);
+        if (connected_port.empty()) return false;
+        if (!idle_connections.empty()) {
+            fd = idle_connections.back();
+            idle_connections.pop_back();
+        }
+    }
+    if (fd < 0 && (fd = connect_daemon()) < 0)
+        return false;
+    if (!exchange(fd, request, response)) {
+        close(fd);
+        return false;
+    }
+    std::lock_guard<decltype(connections_mutex)> lock(connections_mutex);
+    idle_connections.push_back(fd);
+    return true;
+}
+
+/** 转发请求，把应答中的错误记录到错误管理器 */
+handler_t forward(const request_t &request, response_t &response) {
+    handler_t id = ++task_id;
+    if (!call(request, response)) {
+        response = {};
+        exceptions.set(id, error_code::connection_failed, daemon_unavailable);
+    } else if (response.header.code) {
+        exceptions.set_detail(id, static_cast<error_code>(response.header.code), response.text().c_str());
+    }
+    return id;
+}
+
+handler_t forward(const request_t &request) {
+    response_t response{};
+    return forward(request, response);
+}
+
+/** 构造请求 */
+request_t make_request(op_t op,
+                       uint32_t value = 0,
+                       std::initializer_list<double> args = {}) {
+    request_t request;
+    request.header.op    = op;
+    request.header.value = value;
+    std::copy(args.begin(), args.end(), request.header.args);
+    return request;
+}
+
+/** 取出第 index 个浮点返回值，失败时为 NAN；出错时只有动作的进度仍然有效 */
+double value_at(const response_t &response, size_t index = 0) {
+    const auto offset = response.header.code ? response.text().size() + 1 : 0;
+    double     value;
+    return response.get(value, index, offset) ? value : NAN;
+}
+
+/** 取出结构体返回值，失败时为零值 */
+template<class t>
+void struct_at(const response_t &response, t &value) {
+    value = {};
+    if (!response.header.code) response.get(value);
+}
+
+// endregion
+// region subscription
+
+struct subscription_t {
+    int         fd;
+    std::thread thread;
+};
+
+std::mutex                                   subscriptions_mutex;
+std::unordered_map<unsigned, subscription_t> subscriptions;
+unsigned int                                 next_subscription = 0;
+
+// endregion
+
+const char *
+STD_CALL
+autolabor::pm1::native::
+get_error_info(handler_t handler) noexcept {
+    return exceptions[handler];
+}
+
+unsigned int
+STD_CALL
+autolabor::pm1::native::
+get_error_code(handler_t handler) noexcept {
+    return static_cast<unsigned int>(exceptions.code(handler));
+}
+
+void
+STD_CALL
+autolabor::pm1::native::
+remove_error_info(handler_t handler) noexcept {
+    exceptions.remove(handler);
+}
+
+void
+STD_CALL
+autolabor::pm1::native::
+clear_error_info() noexcept {
+    exceptions.clear();
+}
+
+const char *
+STD_CALL
+autolabor::pm1::native::
+get_connected_port() noexcept {
+    return connected_port.c_str();
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_auto_reconnect(bool value) noexcept {
+    return forward(make_request(op_t::set_auto_reconnect, value));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_connection_info_c(connection_info_t *info) noexcept {
+    return get_connection_info(*info);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_connection_info(connection_info_t &info) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_connection_info), response);
+    struct_at(response, info);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+initialize_c(const char *port,
+             double *progress) noexcept {
+    return initialize_ex(port, 115200, false, *progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+initialize(const char *port,
+           double &progress) noexcept {
+    return initialize_ex(port, 115200, false, progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+initialize_ex_c(const char *port,
+                unsigned int baud_rate,
+                bool low_latency,
+                double *progress) noexcept {
+    return initialize_ex(port, baud_rate, low_latency, *progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+initialize_ex(const char *port,
+              unsigned int baud_rate,
+              bool low_latency,
+              double &progress) noexcept {
+    handler_t id = ++task_id;
+    progress = 0;
+    
+    {
+        std::lock_guard<decltype(connections_mutex)> lock(connections_mutex);
+        const auto path = std::getenv("PM1D_SOCKET");
+        socket_path = path ? path : default_socket;
+    }
+    
+    const auto fd = connect_daemon();
+    if (fd < 0) {
+        exceptions.set(id, error_code::connection_failed, daemon_unavailable);
+        return id;
+    }
+    
+    response_t response{};
+    auto       request = make_request(op_t::hello);
+    uint32_t   remote  = 0;
+    if (!exchange(fd, request, response) || !response.get(remote) || remote != version) {
+        close(fd);
+        exceptions.set(id, error_code::connection_failed, "pm1d protocol version mismatch");
+        return id;
+    }
+    
+    request = make_request(op_t::initialize, baud_rate, {low_latency ? 1.0 : 0.0});
+    request.put_text(port);
+    if (!exchange(fd, request, response)) {
+        close(fd);
+        exceptions.set(id, error_code::connection_failed, daemon_unavailable);
+        return id;
+    }
+    if (response.header.code) {
+        close(fd);
+        exceptions.set_detail(id, static_cast<error_code>(response.header.code), response.text().c_str());
+        return id;
+    }
+    
+    std::lock_guard<decltype(connections_mutex)> lock(connections_mutex);
+    connected_port = response.text();
+    idle_connections.push_back(fd);
+    progress = 1;
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+shutdown() noexcept {
+    handler_t id = ++task_id;
+    
+    std::lock_guard<decltype(connections_mutex)> lock(connections_mutex);
+    if (connected_port.empty())
+        exceptions.set(id, error_code::null_chassis, not_connected);
+    for (auto fd : idle_connections) close(fd);
+    idle_connections.clear();
+    connected_port.clear();
+    return id;
+}
+
+double
+STD_CALL
+autolabor::pm1::native::
+get_default_parameter(handler_t id) noexcept {
+    response_t response{};
+    if (!call(make_request(op_t::get_default_parameter, id), response))
+        return NAN;
+    return value_at(response);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_parameter_c(handler_t id, double *value) noexcept {
+    return get_parameter(id, *value);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_parameter(handler_t id, double &value) noexcept {
+    response_t response{};
+    auto       handler = forward(make_request(op_t::get_parameter, id), response);
+    value = value_at(response);
+    return handler;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_parameter(handler_t id, double value) noexcept {
+    return forward(make_request(op_t::set_parameter, id, {value}));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+reset_parameter(handler_t id) noexcept {
+    return forward(make_request(op_t::reset_parameter, id));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_battery_percent(double &battery_percent) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_battery_percent), response);
+    battery_percent = value_at(response);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_rudder_c(double *rudder) noexcept {
+    return get_rudder(*rudder);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_rudder(double &rudder) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_rudder), response);
+    rudder = value_at(response);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_telemetry_c(telemetry_t *telemetry) noexcept {
+    return get_telemetry(*telemetry);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_telemetry(telemetry_t &telemetry) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_telemetry), response);
+    struct_at(response, telemetry);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_rtt_stats_c(unsigned int node, rtt_stats_t *stats) noexcept {
+    return get_rtt_stats(node, *stats);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_rtt_stats(unsigned int node, rtt_stats_t &stats) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_rtt_stats, node), response);
+    struct_at(response, stats);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_poll_period(unsigned int dialog, double period) noexcept {
+    return forward(make_request(op_t::set_poll_period, dialog, {period}));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_polled_c(unsigned int dialog, polled_t *value) noexcept {
+    return get_polled(dialog, *value);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_polled(unsigned int dialog, polled_t &value) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_polled, dialog), response);
+    struct_at(response, value);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+start_telemetry_ring(const char *name, unsigned int capacity) noexcept {
+    auto request = make_request(op_t::start_telemetry_ring, capacity);
+    request.put_text(name);
+    return forward(request);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+stop_telemetry_ring() noexcept {
+    return forward(make_request(op_t::stop_telemetry_ring));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+subscribe_c(unsigned int topics,
+            unsigned int decimation,
+            telemetry_callback_t callback,
+            void *user,
+            unsigned int *subscription) noexcept {
+    return subscribe(topics, decimation, callback, user, *subscription);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+subscribe(unsigned int topics,
+          unsigned int decimation,
+          telemetry_callback_t callback,
+          void *user,
+          unsigned int &subscription) noexcept {
+    handler_t id = ++task_id;
+    subscription = 0;
+    if (!callback) {
+        exceptions.set(id, error_code::other, "null callback");
+        return id;
+    }
+    
+    // 订阅使用专用连接，守护进程在其上持续推送
+    const auto fd = connect_daemon();
+    if (fd < 0) {
+        exceptions.set(id, error_code::connection_failed, daemon_unavailable);
+        return id;
+    }
+    auto request = make_request(op_t::subscribe, topics);
+    request.header.seq = decimation;
+    response_t response{};
+    if (!exchange(fd, request, response) || response.header.code) {
+        close(fd);
+        if (response.header.code)
+            exceptions.set_detail(id, static_cast<error_code>(response.header.code), response.text().c_str());
+        else
+            exceptions.set(id, error_code::connection_failed, daemon_unavailable);
+        return id;
+    }
+    
+    std::lock_guard<decltype(subscriptions_mutex)> lock(subscriptions_mutex);
+    subscription = ++next_subscription;
+    subscriptions[subscription] = {fd, std::thread([fd, callback, user] {
+        response_t frame{};
+        push_t     value;
+        while (receive_message(fd, frame))
+            if (frame.header.op == op_t::telemetry && frame.get(value))
+                callback(&value.telemetry, value.topics, user);
+    })};
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+unsubscribe(unsigned int subscription) noexcept {
+    handler_t      id = ++task_id;
+    subscription_t temp;
+    {
+        std::lock_guard<decltype(subscriptions_mutex)> lock(subscriptions_mutex);
+        auto                                           i = subscriptions.find(subscription);
+        if (i == subscriptions.end()) {
+            exceptions.set(id, error_code::other, "undefined subscription");
+            return id;
+        }
+        temp = std::move(i->second);
+        subscriptions.erase(i);
+    }
+    // 关闭连接使推送线程退出；在回调中取消时不能等待自己。
+    // 本库导出了同名的 C 符号 shutdown，因此直接发起系统调用
+    syscall(SYS_shutdown, temp.fd, SHUT_RDWR);
+    if (temp.thread.get_id() == std::this_thread::get_id())
+        temp.thread.detach();
+    else
+        temp.thread.join();
+    close(temp.fd);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+wait_telemetry_c(unsigned int topics,
+                 unsigned long long after_seq,
+                 double timeout,
+                 telemetry_t *telemetry) noexcept {
+    return wait_telemetry(topics, after_seq, timeout, *telemetry);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+wait_telemetry(unsigned int topics,
+               unsigned long long after_seq,
+               double timeout,
+               telemetry_t &telemetry) noexcept {
+    auto request = make_request(op_t::wait_telemetry, topics, {timeout});
+    request.header.seq = after_seq;
+    response_t response{};
+    auto       id = forward(request, response);
+    struct_at(response, telemetry);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_odometry_c(double *stamp,
+               double *s, double *a,
+               double *x, double *y, double *theta) noexcept {
+    return get_odometry(*stamp, *s, *a, *x, *y, *theta);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_odometry(double &stamp,
+             double &s, double &a,
+             double &x, double &y, double &theta) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_odometry), response);
+    stamp = value_at(response, 0);
+    s     = value_at(response, 1);
+    a     = value_at(response, 2);
+    x     = value_at(response, 3);
+    y     = value_at(response, 4);
+    theta = value_at(response, 5);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+reset_odometry() noexcept {
+    return forward(make_request(op_t::reset_odometry));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_command_enabled(bool value) noexcept {
+    return forward(make_request(op_t::set_command_enabled, value));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_control_rate(double rate) noexcept {
+    return forward(make_request(op_t::set_control_rate, 0, {rate}));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_rudder_prediction(bool value) noexcept {
+    return forward(make_request(op_t::set_rudder_prediction, value));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_lazy_odometry(bool value) noexcept {
+    return forward(make_request(op_t::set_lazy_odometry, value));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_wheel_interpolation(bool value) noexcept {
+    return forward(make_request(op_t::set_wheel_interpolation, value));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_enabled(bool value) noexcept {
+    return forward(make_request(op_t::set_enabled, value));
+}
+
+unsigned char
+STD_CALL
+autolabor::pm1::native::
+check_state() noexcept {
+    response_t response{};
+    double     state;
+    if (!call(make_request(op_t::check_state), response) || !response.get(state))
+        return 0;
+    return static_cast<unsigned char>(state);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_physical(double speed, double rudder) noexcept {
+    return forward(make_request(op_t::drive_physical, 0, {speed, rudder}));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_wheels(double left, double right) noexcept {
+    return forward(make_request(op_t::drive_wheels, 0, {left, right}));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_velocity(double v, double w) noexcept {
+    return forward(make_request(op_t::drive_velocity, 0, {v, w}));
+}
+
+/** 一次发送整批定时控制量，保证替换队尾是原子的 */
+handler_t forward_schedule(op_t op, const native::timed_command_t *commands, unsigned int count) {
+    // 分帧发送时控制节拍可能在两帧之间执行，中途失败还会留下半个规划，因此不能分帧
+    if (count > max_batch) {
+        handler_t id = ++task_id;
+        exceptions.set(id, error_code::undefined_parameter, "too many commands for one request");
+        return id;
+    }
+    auto request = make_request(op);
+    if (count) request.put(commands, count);
+    return forward(request);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+schedule_velocity(const timed_command_t *commands, unsigned int count) noexcept {
+    return forward_schedule(op_t::schedule_velocity, commands, count);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+schedule_physical(const timed_command_t *commands, unsigned int count) noexcept {
+    return forward_schedule(op_t::schedule_physical, commands, count);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+clear_schedule() noexcept {
+    return forward(make_request(op_t::clear_schedule));
+}
+
+/** 按顺序分帧发送路点，首帧之后的路点追加在路径末尾 */
+handler_t forward_path(request_t request, const native::waypoint_t *points, unsigned int count) {
+    handler_t id = 0;
+    size_t    i  = 0;
+    do {
+        const auto size = std::min<size_t>(max_batch, count - i);
+        request.payload.clear();
+        if (size) request.put(points + i, size);
+        id = forward(request);
+        if (exceptions.code(id) != error_code{}) break;
+        request = make_request(op_t::append_path);
+    } while ((i += max_batch) < count);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+follow_path(const waypoint_t *points,
+            unsigned int count,
+            double speed,
+            double lookahead) noexcept {
+    return forward_path(make_request(op_t::follow_path, 0, {speed, lookahead}), points, count);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+append_path(const waypoint_t *points, unsigned int count) noexcept {
+    return forward_path(make_request(op_t::append_path), points, count);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+clear_path() noexcept {
+    return forward(make_request(op_t::clear_path));
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_path_stats_c(path_stats_t *stats) noexcept {
+    return get_path_stats(*stats);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_path_stats(path_stats_t &stats) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::get_path_stats), response);
+    struct_at(response, stats);
+    return id;
+}
+
+double
+STD_CALL
+autolabor::pm1::native::
+calculate_spatium(double spatium,
+                  double angle,
+                  double width) noexcept {
+    response_t response{};
+    if (!call(make_request(op_t::calculate_spatium, 0, {spatium, angle, width}), response))
+        return NAN;
+    return value_at(response);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_spatial(double v,
+              double w,
+              double spatium,
+              double angle,
+              double &progress) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::drive_spatial, 0, {v, w, spatium, angle}), response);
+    progress = value_at(response);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_spatial_c(double v,
+                double w,
+                double spatium,
+                double angle,
+                double *progress) noexcept {
+    return drive_spatial(v, w, spatium, angle, *progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_segments(const segment_t *segments,
+               unsigned int count,
+               double &progress) noexcept {
+    progress = 0;
+    // 运动段要一次规划才能省去段间停车，不能分帧
+    if (count > max_batch) {
+        handler_t id = ++task_id;
+        exceptions.set(id, error_code::undefined_parameter, "too many segments for one request");
+        return id;
+    }
+    auto request = make_request(op_t::drive_segments);
+    if (count) request.put(segments, count);
+    response_t response{};
+    auto       id = forward(request, response);
+    progress = value_at(response);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_segments_c(const segment_t *segments,
+                 unsigned int count,
+                 double *progress) noexcept {
+    return drive_segments(segments, count, *progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_timing(double v,
+             double w,
+             double time,
+             double &progress) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::drive_timing, 0, {v, w, time}), response);
+    progress = value_at(response);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+adjust_rudder(double offset,
+              double &progress) noexcept {
+    response_t response{};
+    auto       id = forward(make_request(op_t::adjust_rudder, 0, {offset}), response);
+    progress = value_at(response);
+    return id;
+}
+
+void
+STD_CALL
+autolabor::pm1::native::
+set_paused(bool value) noexcept {
+    response_t response{};
+    call(make_request(op_t::set_paused, value), response);
+}
+
+bool
+STD_CALL
+autolabor::pm1::native::
+is_paused() noexcept {
+    response_t response{};
+    return call(make_request(op_t::is_paused), response) && value_at(response) > 0;
+}
+
+void
+STD_CALL
+autolabor::pm1::native::
+cancel_action() noexcept {
+    response_t response{};
+    call(make_request(op_t::cancel_action), response);
+}
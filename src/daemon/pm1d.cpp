@@ -0,0 +1,401 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "pm1d_protocol.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+
+using namespace autolabor::pm1;
+using namespace autolabor::pm1::daemon;
+
+// region response
+
+/** 把操作结果写入应答，成功时返回 true，失败时负载以错误信息开头 */
+bool set_result(native::handler_t handler, response_t &response) {
+    response.header.code = native::get_error_code(handler);
+    if (!response.header.code) return true;
+    response.payload.clear();
+    response.put_text(native::get_error_info(handler));
+    native::remove_error_info(handler);
+    return false;
+}
+
+/** 写入浮点返回值 */
+void put_values(response_t &response, std::initializer_list<double> values) {
+    response.put(values.begin(), values.size());
+}
+
+/** 订阅推送：在 SDK 读线程中调用，套接字写满时丢弃，不阻塞读线程 */
+void STD_CALL push(const native::telemetry_t *telemetry, unsigned int topics, void *user) {
+    response_t response;
+    response.header.op = op_t::telemetry;
+    const push_t value{topics, *telemetry};
+    response.put(&value);
+    send_message(static_cast<int>(reinterpret_cast<intptr_t>(user)), response, MSG_DONTWAIT | MSG_NOSIGNAL);
+}
+
+/** 执行一个请求 */
+void execute(const request_t &request, response_t &response) {
+    const auto &h = request.header;
+    const auto &a = h.args;
+    
+    response.header.op = h.op;
+    switch (h.op) {
+        case op_t::hello:
+            response.put(&version);
+            break;
+        case op_t::initialize:
+            // 守护进程已连接底盘时不重新初始化，串口设置以首次连接为准
+            if (!*native::get_connected_port()) {
+                double progress;
+                if (!set_result(native::initialize_ex(request.text().c_str(),
+                                                      h.value ? h.value : 115200,
+                                                      a[0] != 0,
+                                                      progress), response))
+                    break;
+            }
+            response.put_text(native::get_connected_port());
+            break;
+        case op_t::set_auto_reconnect:
+            set_result(native::set_auto_reconnect(h.value), response);
+            break;
+        case op_t::get_connection_info: {
+            native::connection_info_t info{};
+            if (set_result(native::get_connection_info(info), response))
+                response.put(&info);
+            break;
+        }
+        case op_t::get_default_parameter:
+            put_values(response, {native::get_default_parameter(h.value)});
+            break;
+        case op_t::get_parameter: {
+            double value;
+            if (set_result(native::get_parameter(h.value, value), response))
+                put_values(response, {value});
+            break;
+        }
+        case op_t::set_parameter:
+            set_result(native::set_parameter(h.value, a[0]), response);
+            break;
+        case op_t::reset_parameter:
+            set_result(native::reset_parameter(h.value), response);
+            break;
+        case op_t::get_battery_percent: {
+            double value;
+            if (set_result(native::get_battery_percent(value), response))
+                put_values(response, {value});
+            break;
+        }
+        case op_t::get_rudder: {
+            double value;
+            if (set_result(native::get_rudder(value), response))
+                put_values(response, {value});
+            break;
+        }
+        case op_t::get_telemetry: {
+            native::telemetry_t telemetry{};
+            if (set_result(native::get_telemetry(telemetry), response))
+                response.put(&telemetry);
+            break;
+        }
+        case op_t::get_rtt_stats: {
+            native::rtt_stats_t stats{};
+            if (set_result(native::get_rtt_stats(h.value, stats), response))
+                response.put(&stats);
+            break;
+        }
+        case op_t::set_poll_period:
+            set_result(native::set_poll_period(h.value, a[0]), response);
+            break;
+        case op_t::get_polled: {
+            native::polled_t polled{};
+            if (set_result(native::get_polled(h.value, polled), response))
+                response.put(&polled);
+            break;
+        }
+        case op_t::start_telemetry_ring:
+            set_result(native::start_telemetry_ring(request.text().c_str(), h.value), response);
+            break;
+        case op_t::stop_telemetry_ring:
+            set_result(native::stop_telemetry_ring(), response);
+            break;
+        case op_t::wait_telemetry: {
+            native::telemetry_t telemetry{};
+            if (set_result(native::wait_telemetry(h.value, h.seq, a[0], telemetry), response))
+                response.put(&telemetry);
+            break;
+        }
+        case op_t::get_odometry: {
+            double stamp, s, a_, x, y, theta;
+            if (set_result(native::get_odometry(stamp, s, a_, x, y, theta), response))
+                put_values(response, {stamp, s, a_, x, y, theta});
+            break;
+        }
+        case op_t::reset_odometry:
+            set_result(native::reset_odometry(), response);
+            break;
+        case op_t::set_command_enabled:
+            set_result(native::set_command_enabled(h.value), response);
+            break;
+        case op_t::set_control_rate:
+            set_result(native::set_control_rate(a[0]), response);
+            break;
+        case op_t::set_rudder_prediction:
+            set_result(native::set_rudder_prediction(h.value), response);
+            break;
+        case op_t::set_lazy_odometry:
+            set_result(native::set_lazy_odometry(h.value), response);
+            break;
+        case op_t::set_wheel_interpolation:
+            set_result(native::set_wheel_interpolation(h.value), response);
+            break;
+        case op_t::set_enabled:
+            set_result(native::set_enabled(h.value), response);
+            break;
+        case op_t::check_state:
+            put_values(response, {static_cast<double>(native::check_state())});
+            break;
+        case op_t::drive_physical:
+            set_result(native::drive_physical(a[0], a[1]), response);
+            break;
+        case op_t::drive_wheels:
+            set_result(native::drive_wheels(a[0], a[1]), response);
+            break;
+        case op_t::drive_velocity:
+            set_result(native::drive_velocity(a[0], a[1]), response);
+            break;
+        case op_t::schedule_velocity: {
+            const auto commands = request.array<native::timed_command_t>();
+            set_result(native::schedule_velocity(commands.data(), static_cast<unsigned>(commands.size())), response);
+            break;
+        }
+        case op_t::schedule_physical: {
+            const auto commands = request.array<native::timed_command_t>();
+            set_result(native::schedule_physical(commands.data(), static_cast<unsigned>(commands.size())), response);
+            break;
+        }
+        case op_t::clear_schedule:
+            set_result(native::clear_schedule(), response);
+            break;
+        case op_t::follow_path: {
+            const auto points = request.array<native::waypoint_t>();
+            set_result(native::follow_path(points.data(), static_cast<unsigned>(points.size()), a[0], a[1]), response);
+            break;
+        }
+        case op_t::append_path: {
+            const auto points = request.array<native::waypoint_t>();
+            set_result(native::append_path(points.data(), static_cast<unsigned>(points.size())), response);
+            break;
+        }
+        case op_t::clear_path:
+            set_result(native::clear_path(), response);
+            break;
+        case op_t::get_path_stats: {
+            native::path_stats_t stats{};
+            if (set_result(native::get_path_stats(stats), response))
+                response.put(&stats);
+            break;
+        }
+        case op_t::calculate_spatium:
+            put_values(response, {native::calculate_spatium(a[0], a[1], a[2])});
+            break;
+        case op_t::drive_spatial: {
+            // 动作出错时进度仍然有效，跟随在错误信息之后
+            double progress;
+            set_result(native::drive_spatial(a[0], a[1], a[2], a[3], progress), response);
+            put_values(response, {progress});
+            break;
+        }
+        case op_t::drive_segments: {
+            const auto segments = request.array<native::segment_t>();
+            double     progress;
+            set_result(native::drive_segments(segments.data(), static_cast<unsigned>(segments.size()), progress), response);
+            put_values(response, {progress});
+            break;
+        }
+        case op_t::drive_timing: {
+            double progress;
+            set_result(native::drive_timing(a[0], a[1], a[2], progress), response);
+            put_values(response, {progress});
+            break;
+        }
+        case op_t::adjust_rudder: {
+            double progress;
+            set_result(native::adjust_rudder(a[0], progress), response);
+            put_values(response, {progress});
+            break;
+        }
+        case op_t::set_paused:
+            native::set_paused(h.value);
+            break;
+        case op_t::is_paused:
+            put_values(response, {native::is_paused() ? 1.0 : 0.0});
+            break;
+        case op_t::cancel_action:
+            native::cancel_action();
+            break;
+        default:
+            response.header.code = static_cast<uint32_t>(error_code::other);
+            response.put_text("unknown operation");
+            break;
+    }
+}
+
+/** 阻塞动作，执行期间发起请求的连接是动作的所有者 */
+bool is_action(op_t op) {
+    return op == op_t::drive_spatial
+           || op == op_t::drive_segments
+           || op == op_t::drive_timing
+           || op == op_t::adjust_rudder;
+}
+
+/**
+ * 执行阻塞动作，所有者断开连接时取消动作
+ *
+ * 所有者在动作完成前不会在这个连接上发送新请求，
+ * 因此执行期间连接上的任何事件都表示对端已关闭
+ */
+void execute_action(int client, const request_t &request, response_t &response) {
+    constexpr int check_ms = 50;
+    
+    std::mutex mutex;
+    bool       done = false;
+    
+    std::thread watcher([&] {
+        pollfd fd{client, POLLRDHUP, 0};
+        std::unique_lock<decltype(mutex)> lock(mutex);
+        while (!done) {
+            lock.unlock();
+            const auto events = poll(&fd, 1, check_ms);
+            lock.lock();
+            // 持锁判断，动作已结束时不会误取消其他连接之后发起的动作
+            if (events > 0 && !done) {
+                native::cancel_action();
+                break;
+            }
+        }
+    });
+    execute(request, response);
+    {
+        std::lock_guard<decltype(mutex)> lock(mutex);
+        done = true;
+    }
+    watcher.join();
+}
+
+// endregion
+
+/** 服务一个客户端连接 */
+void serve(int client) {
+    request_t request;
+    while (receive_message(client, request)) {
+        if (request.header.op == op_t::subscribe) {
+            // 连接转为推送专用，对端关闭时取消订阅
+            unsigned int subscription;
+            auto         handler = native::subscribe(request.header.value,
+                                                     static_cast<unsigned int>(request.header.seq),
+                                                     push,
+                                                     reinterpret_cast<void *>(static_cast<intptr_t>(client)),
+                                                     subscription);
+            response_t   response;
+            response.header.op = op_t::subscribe;
+            if (set_result(handler, response)) {
+                if (send_message(client, response, MSG_NOSIGNAL)) {
+                    char _;
+                    while (recv(client, &_, sizeof(_), 0) > 0);
+                }
+                native::unsubscribe(subscription);
+            } else {
+                send_message(client, response, MSG_NOSIGNAL);
+            }
+            break;
+        }
+        response_t response;
+        if (is_action(request.header.op))
+            execute_action(client, request, response);
+        else
+            execute(request, response);
+        if (!send_message(client, response, MSG_NOSIGNAL))
+            break;
+    }
+    close(client);
+}
+
+int main(int argc, char **argv) {
+    const std::string
+        port   = argc > 1 ? argv[1] : "",
+        path   = argc > 2 ? argv[2] : std::getenv("PM1D_SOCKET") ? std::getenv("PM1D_SOCKET") : default_socket;
+    const auto
+        baud_rate   = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 115200u;
+    const auto
+        low_latency = argc > 4 && std::strcmp(argv[4], "0") != 0;
+    
+    // 先屏蔽退出信号，之后创建的所有线程都继承屏蔽字
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+    
+    double progress;
+    auto   handler = native::initialize_ex(port.c_str(), baud_rate, low_latency, progress);
+    if (native::get_error_code(handler)) {
+        std::cerr << native::get_error_info(handler) << std::endl;
+        return 1;
+    }
+    std::cout << "pm1d: chassis on " << native::get_connected_port() << std::endl;
+    
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "socket path is too long" << std::endl;
+        return 1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    
+    const auto server = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    unlink(path.c_str());
+    if (server < 0
+        || bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0
+        || listen(server, 16) < 0) {
+        std::cerr << "failed to listen on " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cout << "pm1d: listening on " << path << std::endl;
+    
+    // 在专用线程中等待退出信号，关闭监听套接字以结束主循环
+    std::thread([signals, server] {
+        int _;
+        sigwait(&signals, &_);
+        // SDK 导出了同名的 C 符号 shutdown，因此直接发起系统调用
+        syscall(SYS_shutdown, server, SHUT_RDWR);
+    }).detach();
+    
+    while (true) {
+        const auto client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        std::thread(serve, client).detach();
+    }
+    
+    close(server);
+    unlink(path.c_str());
+    native::shutdown();
+    return 0;
+}
@@ -0,0 +1,205 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_PM1D_PROTOCOL_H
+#define PM1_SDK_PM1D_PROTOCOL_H
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "pm1_sdk_native.h"
+#include "pm1_sdk_definitions.h"
+
+/**
+ * pm1d 本地守护进程协议
+ *
+ * 客户端通过 Unix 域套接字（SOCK_SEQPACKET）发送请求报文，
+ * 守护进程在同一连接上回复一个应答报文；
+ * 订阅请求之后，守护进程在该连接上持续推送应答报文，直到连接关闭。
+ * 每个连接同一时刻只有一个请求，并发请求使用多个连接。
+ *
+ * 报文由定长头部和按操作码确定的变长负载组成，负载只携带该操作实际用到的数据。
+ * 应答负载是按原函数输出参数顺序排列的返回值；
+ * 错误码非 0 时负载以错误信息开头，之后只跟随出错时仍然有效的返回值（动作的进度）
+ */
+namespace autolabor {
+    namespace pm1 {
+        namespace daemon {
+            /** 默认套接字路径，可用环境变量 PM1D_SOCKET 覆盖 */
+            constexpr auto default_socket = "/tmp/pm1d.sock";
+            
+            /** 协议版本，不一致时拒绝连接 */
+            constexpr uint32_t version = 14;
+            
+            /** 负载长度上限，超过上限的报文视为协议错误并关闭连接 */
+            constexpr size_t max_payload = 64 * 1024;
+            
+            /** 每个请求携带的定时控制量、运动段和路点上限，更长的路径由客户端分批追加 */
+            constexpr uint32_t max_batch = 1024;
+            
+            static_assert(max_batch * sizeof(native::segment_t) <= max_payload, "segments exceed payload");
+            static_assert(max_batch * sizeof(native::timed_command_t) <= max_payload, "commands exceed payload");
+            static_assert(max_batch * sizeof(native::waypoint_t) <= max_payload, "waypoints exceed payload");
+            
+            /**
+             * 操作码，与 pm1_sdk_native.h 中的函数一一对应
+             *
+             * 注释说明请求头部以外的负载，未注明的操作请求负载为空、应答负载为输出参数
+             */
+            enum class op_t : uint32_t {
+                hello,                // 应答负载为协议版本
+                initialize,           // 请求负载为串口名字，应答负载为实际连接的串口名字
+                set_auto_reconnect,
+                get_connection_info,
+                get_default_parameter,
+                get_parameter,
+                set_parameter,
+                reset_parameter,
+                get_battery_percent,
+                get_rudder,
+                get_telemetry,
+                get_rtt_stats,        // value 为节点序号
+                set_poll_period,      // value 为对话
+                get_polled,           // value 为对话
+                start_telemetry_ring, // 请求负载为共享内存名字
+                stop_telemetry_ring,
+                subscribe,            // value 为订阅项目，seq 为抽取倍数
+                wait_telemetry,       // value 为等待项目，seq 为已取得的序号
+                get_odometry,
+                reset_odometry,
+                set_command_enabled,
+                set_control_rate,
+                set_rudder_prediction,
+                set_lazy_odometry,
+                set_wheel_interpolation,
+                set_enabled,
+                check_state,
+                drive_physical,
+                drive_wheels,
+                drive_velocity,
+                schedule_velocity,    // 请求负载为定时控制量
+                schedule_physical,    // 请求负载为定时控制量
+                clear_schedule,
+                follow_path,          // 请求负载为路点
+                append_path,          // 请求负载为路点
+                clear_path,
+                get_path_stats,
+                calculate_spatium,
+                drive_spatial,
+                drive_segments,       // 请求负载为运动段
+                drive_timing,
+                adjust_rudder,
+                set_paused,
+                is_paused,
+                cancel_action,
+                telemetry,            // 订阅推送，负载见 push_t
+            };
+            
+            /** 请求头部 */
+            struct request_header_t {
+                op_t     op;
+                uint32_t value;   // 整型参数：参数号、订阅项目、布尔值等
+                uint64_t seq;     // 序号参数
+                double   args[4]; // 浮点参数，按原函数参数顺序
+            };
+            
+            /** 应答头部 */
+            struct response_header_t {
+                op_t     op;
+                uint32_t code; // 错误码，见 error_code
+            };
+            
+            /** 订阅推送的负载 */
+            struct push_t {
+                uint32_t            topics; // 本次变化的项目，见 topic
+                native::telemetry_t telemetry;
+            };
+            
+            /** 报文：头部和负载 */
+            template<class header_t>
+            struct message_t {
+                header_t          header{};
+                std::vector<char> payload;
+                
+                /** 追加到负载末尾 */
+                template<class t>
+                void put(const t *data, size_t count = 1) {
+                    const auto bytes = reinterpret_cast<const char *>(data);
+                    payload.insert(payload.end(), bytes, bytes + count * sizeof(t));
+                }
+                
+                /** 追加以 0 结尾的字符串 */
+                void put_text(const char *text) {
+                    if (text) put(text, std::strlen(text));
+                    payload.push_back('\0');
+                }
+                
+                /** 按类型取出负载中从 offset 字节开始的第 index 项，负载不够长时返回 false */
+                template<class t>
+                bool get(t &value, size_t index = 0, size_t offset = 0) const {
+                    if (payload.size() < offset + (index + 1) * sizeof(t)) return false;
+                    std::memcpy(&value, payload.data() + offset + index * sizeof(t), sizeof(t));
+                    return true;
+                }
+                
+                /** 把整个负载作为数组取出 */
+                template<class t>
+                std::vector<t> array() const {
+                    std::vector<t> result(payload.size() / sizeof(t));
+                    if (!result.empty()) std::memcpy(result.data(), payload.data(), result.size() * sizeof(t));
+                    return result;
+                }
+                
+                /** 把负载作为字符串取出 */
+                std::string text() const {
+                    return std::string(payload.data(), strnlen(payload.data(), payload.size()));
+                }
+            };
+            
+            using request_t  = message_t<request_header_t>;
+            using response_t = message_t<response_header_t>;
+            
+            /** 发送一个报文，flags 同 send */
+            template<class header_t>
+            bool send_message(int fd, const message_t<header_t> &message, int flags) {
+                iovec parts[]{
+                    {const_cast<header_t *>(&message.header), sizeof(header_t)},
+                    {const_cast<char *>(message.payload.data()), message.payload.size()},
+                };
+                msghdr msg{};
+                msg.msg_iov    = parts;
+                msg.msg_iovlen = 2;
+                return sendmsg(fd, &msg, flags) == static_cast<ssize_t>(sizeof(header_t) + message.payload.size());
+            }
+            
+            /** 接收一个报文，连接关闭或报文长度不合法时返回 false */
+            template<class header_t>
+            bool receive_message(int fd, message_t<header_t> &message) {
+                // 先窥视报文长度，负载只分配实际需要的大小
+                const auto size = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+                if (size < static_cast<ssize_t>(sizeof(header_t))
+                    || size > static_cast<ssize_t>(sizeof(header_t) + max_payload))
+                    return false;
+                message.payload.resize(static_cast<size_t>(size) - sizeof(header_t));
+                iovec parts[]{
+                    {&message.header, sizeof(header_t)},
+                    {message.payload.data(), message.payload.size()},
+                };
+                msghdr msg{};
+                msg.msg_iov    = parts;
+                msg.msg_iovlen = 2;
+                return recvmsg(fd, &msg, 0) == size;
+            }
+        }
+    }
+}
+
+
+#endif //PM1_SDK_PM1D_PROTOCOL_H
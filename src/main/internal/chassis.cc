@@ -8,6 +8,7 @@
 #include <condition_variable>
 
 #include <utilities/serial_parser/parse_engine.hpp>
+#include <utilities/serial_port/serial.h>
 #include <utilities/differentiator_t.hpp>
 
 #include "can/parser_t.hpp"
@@ -20,6 +21,8 @@ extern "C" {
 
 using namespace autolabor::pm1;
 
+std::atomic<unsigned long long> chassis::telemetry_seq{0};
+
 // region functions
 
 template<class t>
@@ -55,6 +58,24 @@ constexpr uint64_t count_ms(t time) noexcept {
     return std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
 }
 
+/** 查找串口的硬件标识 */
+std::string hardware_id_of(const std::string &port_name) {
+    for (const auto &info : serial::list_ports())
+        if (info.port == port_name)
+            return info.hardware_id;
+    return {};
+}
+
+/** 按硬件标识查找串口，标识不唯一或找不到时沿用原来的名字 */
+std::string find_port(const std::string &port_name, const std::string &hardware_id) {
+    if (hardware_id.find("SNR=") == std::string::npos)
+        return port_name;
+    for (const auto &info : serial::list_ports())
+        if (info.hardware_id == hardware_id)
+            return info.port;
+    return port_name;
+}
+
 // endregion
 
 const float
@@ -62,7 +83,8 @@ const float
     chassis::default_max_v           = default_max_wheel_speed,
     chassis::default_max_w           = pi_f / 4,
     chassis::default_optimize_width  = pi_f / 4,
-    chassis::default_acceleration    = 1;
+    chassis::default_acceleration    = 1,
+    chassis::default_jerk            = 0;
 
 #if   defined(WIN32)
 
@@ -85,10 +107,13 @@ constexpr auto
     odometry_interval   = 50ms,
     rudder_interval     = 20ms,
     state_interval      = 1000ms,
-    state_timeout       = state_interval + 100ms,
+    state_margin        = 100ms,
     control_timeout     = 500ms,
     check_timeout       = 1000ms,
-    check_state_timeout = 100ms;
+    check_state_timeout = 100ms,
+    reconnect_interval  = 100ms,
+    reconnect_timeout   = 5000ms,
+    traffic_interval    = 1000ms;
 constexpr auto
     timeout_gcd         = gcd(count_ms(state_interval),
                               gcd(count_ms(odometry_interval),
@@ -96,24 +121,37 @@ constexpr auto
 constexpr auto
     delay_interval      = std::chrono::milliseconds(max_of(5, timeout_gcd - 1));
 
-chassis::chassis(const std::string &port_name)
-    : port(port_name, 115200, timeout),
+chassis::chassis(const std::string &port_name,
+                 unsigned int baud_rate,
+                 bool low_latency,
+                 const std::atomic<bool> *cancel)
+    : port(port_name, baud_rate, timeout, 1, 0x100, 0x100,
+           low_latency ? sizeof(can::pack_with_data) : 0),
+      hardware_id(hardware_id_of(port_name)),
+      tune_latency(low_latency),
       running(true),
-      command_enabled(true),
       config(default_config),
       max_v(default_max_v),
       max_w(default_max_w),
       max_wheel_speed(default_max_wheel_speed),
       optimize_width(default_optimize_width),
       acceleration(default_acceleration),
+      jerk(default_jerk),
+      command_enabled(true),
+      auto_reconnect(false),
+      predict_rudder(false),
+      budget(baud_rate),
       enabled_target(false) {
     
     using result_t = can::parser_t::result_type_t;
     using engine_t = parse_engine_t<can::parser_t>;
     
+    _link.original_latency_timer = -1;
+    
     port << can::pack<ecu<>::timeout>({2, 0}) // 设置动力超时时间到 200 ms
          << can::pack<unit<>::emergency_stop>();          // 从锁定状态启动
     
+    plan_link();
     start_write_loop();
     
     // region check nodes
@@ -127,8 +165,11 @@ chassis::chassis(const std::string &port_name)
     
             std::mutex                   signal_mutex;
             std::unique_lock<std::mutex> own(signal_mutex);
-            if (signal.wait_for(own, check_timeout, [&] { return !running || (temp[0] && temp[1] && temp[2]); }))
-                return;
+            // 分段等待以便及时响应取消
+            const auto deadline = now() + check_timeout;
+            while (!(cancel && *cancel) && now() < deadline)
+                if (signal.wait_for(own, 10ms, [&] { return !running || (temp[0] && temp[1] && temp[2]); }))
+                    return;
     
             stop_all();
         });
@@ -140,15 +181,18 @@ chassis::chassis(const std::string &port_name)
         
             switch (_odometry.try_parse(_now, result.message, config)) {
                 case pm1_odometry_t::result_type::left:
+                    rtt[0].received(position_query, _now);
                     temp[0] = true;
                     break;
                 case pm1_odometry_t::result_type::right:
+                    rtt[1].received(position_query, _now);
                     temp[1] = true;
                     break;
                 case pm1_odometry_t::result_type::none: {
+                    rtt[2].received(position_query, _now);
                     const auto last  = _rudder;
                     const auto value = RAD_OF(get_data_value<short>(result.message), default_rudder_k);
-                    _rudder = {_now, {value, value - last.value.position / duration_seconds(_now - last.time)}};
+                    _rudder = {_now, {value, (value - last.value.position) / duration_seconds(_now - last.time)}};
                 }
                     temp[2] = true;
                     break;
@@ -176,10 +220,11 @@ chassis::chassis(const std::string &port_name)
         timer.join();
     }
     // endregion
+    // 确认是底盘之后才调整定时器：构造失败不会执行析构，无法恢复原值
+    update_latency_timer();
     // region receive
     read_thread = std::thread([=] {
-        const auto t0    = now();
-        auto       speed = .0f;
+        const auto t0 = now();
     
         std::array<decltype(now()), 4> reply_time{t0, t0, t0, t0};
         
@@ -189,13 +234,14 @@ chassis::chassis(const std::string &port_name)
             auto _now = now();
             
             for (size_t i = 0; i < reply_time.size(); ++i)
-                if (_now - reply_time[i] > state_timeout)
+                if (_now - reply_time[i] > node_timeout(i))
                     chassis_state.states[i] = node_state_t::unknown;
             
             auto msg = result.message;
     
             if (unit<ecu<0>>::state_rx::match(msg)) {
                 reply_time[0] = _now;
+                rtt[0].received(state_query, _now);
                 if (node_state_t::enabled == (chassis_state.ecu0() = parse_state(*msg.data))) {
                     if (!enabled_target)
                         port << can::pack<unit<ecu<0>>::emergency_stop>();
@@ -206,6 +252,7 @@ chassis::chassis(const std::string &port_name)
         
             } else if (unit<ecu<1>>::state_rx::match(msg)) {
                 reply_time[1] = _now;
+                rtt[1].received(state_query, _now);
                 if (node_state_t::enabled == (chassis_state.ecu1() = parse_state(*msg.data))) {
                     if (!enabled_target)
                         port << can::pack<unit<ecu<1>>::emergency_stop>();
@@ -216,6 +263,7 @@ chassis::chassis(const std::string &port_name)
         
             } else if (unit<tcu<0>>::state_rx::match(msg)) {
                 reply_time[2] = _now;
+                rtt[2].received(state_query, _now);
                 if (node_state_t::enabled == (chassis_state.tcu() = parse_state(*msg.data))) {
                     if (!enabled_target)
                         port << can::pack<unit<tcu<0>>::emergency_stop>();
@@ -226,40 +274,42 @@ chassis::chassis(const std::string &port_name)
         
             } else if (unit<vcu<0>>::state_rx::match(msg)) {
                 reply_time[3] = _now;
+                rtt[3].received(state_query, _now);
                 chassis_state.vcu() = parse_state(*msg.data);
         
             } else if (vcu<0>::battery_percent_rx::match(msg)) {
+                rtt[3].received(battery_query, _now);
                 _battery = *msg.data;
         
             } else if (tcu<0>::current_position_rx::match(msg)) {
-        
+                rtt[2].received(position_query, _now);
+                
                 const auto last  = _rudder;
                 const auto value = RAD_OF(get_data_value<short>(result.message), default_rudder_k);
                 if (value < -M_PI / 2 || M_PI / 2 < value)
                     return;
-                _rudder = {_now, {value, value - last.value.position / duration_seconds(_now - last.time)}};
+                _rudder = {_now, {value, (value - last.value.position) / duration_seconds(_now - last.time)}};
+                rudder_samples.write(_rudder);
                 
-                if (std::isnan(target.rudder) || now() - request_time > control_timeout)
-                    target = {0, value};
-        
-                constexpr static auto period = duration_seconds<float>(rudder_interval);
-        
-                auto optimized = optimize(target, {speed, value},
-                                          optimize_width, acceleration * period);
-                speed = optimized.speed;
-        
-                auto wheels = physical_to_wheels(optimized, &config);
-                auto left   = PULSES_OF(wheels.left, default_wheel_k);
-                auto right  = PULSES_OF(wheels.right, default_wheel_k);
-                auto rudder = static_cast<short>(PULSES_OF(target.rudder, default_rudder_k));
-        
-                if (command_enabled)
-                    port << pack_value<ecu<0>::target_speed, int>(left)
-                         << pack_value<ecu<1>::target_speed, int>(right)
-                         << pack_value<tcu<0>::target_position, short>(rudder);
+                // 未设置控制频率时，控制节拍跟随舵轮应答
+                if (control_rate.load() == 0)
+                    control_cycle(_now, rudder_interval,
+                                  std::min<decltype(_now - last.time)>((_now - last.time) / 2, rudder_interval));
             } else {
-                _odometry.try_parse(_now, msg, config);
+                switch (_odometry.try_parse(_now, msg, config)) {
+                    case pm1_odometry_t::result_type::left:
+                        rtt[0].received(position_query, _now);
+                        break;
+                    case pm1_odometry_t::result_type::right:
+                        rtt[1].received(position_query, _now);
+                        break;
+                    case pm1_odometry_t::result_type::none:
+                        polls.parse(_now, msg);
+                        break;
+                }
             }
+            
+            publish(_now);
         };
         
         engine_t engine;
@@ -268,9 +318,14 @@ chassis::chassis(const std::string &port_name)
             try {
                 engine(buffer, buffer + port.read(buffer, sizeof(buffer)), parse);
             } catch (...) {
-                stop_all();
+                // 重连后丢弃残帧，重新同步解析器
+                if (auto_reconnect && reconnect())
+                    engine = engine_t{};
+                else
+                    stop_all();
             }
     });
+    start_control_loop();
     // endregion
     // region wait state
     const auto end = now() + state_interval + check_state_timeout;
@@ -289,6 +344,10 @@ chassis::~chassis() {
     stop_all();
     read_thread.join();
     write_thread.join();
+    control_thread.join();
+    
+    if (_link.original_latency_timer >= 0)
+        serial::set_latency_timer(port.name(), _link.original_latency_timer);
 }
 
 //==============================================================
@@ -332,6 +391,147 @@ bool chassis::is_threads_running() const {
     return running;
 }
 
+telemetry_snapshot_t chassis::telemetry() const {
+    std::lock_guard<decltype(telemetry_mutex)> lock(telemetry_mutex);
+    auto result = _telemetry;
+    if (_odometry.lazy()) result.odometry = _odometry.value().value;
+    if (!running) result.state = {};
+    return result;
+}
+
+void chassis::set_lazy_odometry(bool value) {
+    _odometry.set_lazy(value);
+}
+
+bool chassis::is_odometry_lazy() const {
+    return _odometry.lazy();
+}
+
+void chassis::set_wheel_interpolation(bool value) {
+    _odometry.set_interpolate(value);
+}
+
+void chassis::publish(decltype(now()) _now) {
+    // 延迟推算位姿时只按配对时刻判断里程计更新，快照中的位姿由读取者推算
+    const auto time = _odometry.time();
+    const auto lazy = _odometry.lazy();
+    
+    unsigned int         changed = 0;
+    telemetry_snapshot_t snapshot;
+    {
+        std::lock_guard<decltype(telemetry_mutex)> lock(telemetry_mutex);
+        if (time != odometry_time) {
+            odometry_time = time;
+            changed |= static_cast<unsigned int>(topic::odometry);
+            if (!lazy) _telemetry.odometry = _odometry.value().value;
+        }
+        if (_rudder.time != rudder_time) {
+            rudder_time = _rudder.time;
+            changed |= static_cast<unsigned int>(topic::rudder);
+        }
+        if (chassis_state.states != _telemetry.state.states)
+            changed |= static_cast<unsigned int>(topic::state);
+        if (_battery / 100.0 != _telemetry.battery_percent)
+            changed |= static_cast<unsigned int>(topic::battery);
+        if (!changed) return;
+        
+        _telemetry.seq             = ++telemetry_seq;
+        _telemetry.time            = _now;
+        _telemetry.left            = _odometry._left.value;
+        _telemetry.right           = _odometry._right.value;
+        _telemetry.rudder          = _rudder.value;
+        _telemetry.state           = chassis_state;
+        _telemetry.battery_percent = _battery / 100.0;
+        snapshot = _telemetry;
+    }
+    // 在锁外通知，回调中可以再次读取快照
+    if (auto f = observer.load()) f(*this, snapshot, changed);
+}
+
+void chassis::update_latency_timer() {
+    const auto name    = port.name();
+    const auto current = serial::get_latency_timer(name);
+    // 重连后适配器重新枚举，定时器回到驱动默认值，需要再次调整，原值只记录第一次的
+    const auto tuned   = tune_latency && current > 1 && serial::set_latency_timer(name, 1);
+    
+    std::lock_guard<decltype(link_mutex)> lock(link_mutex);
+    _link.latency_timer = tuned ? 1 : current;
+    if (tuned && _link.original_latency_timer < 0)
+        _link.original_latency_timer = current;
+}
+
+link_stats_t chassis::link_stats() const {
+    std::lock_guard<decltype(link_mutex)> lock(link_mutex);
+    return _link;
+}
+
+autolabor::rtt_stats_t chassis::rtt_stats(size_t node) const {
+    return rtt.at(node).stats();
+}
+
+autolabor::seconds_floating chassis::node_timeout(size_t node) const {
+    // 查询周期之外留出 4 倍 99% 分位往返时间，不少于原来的 100 ms，不多于一个查询周期
+    const auto margin = std::min<seconds_floating>(seconds_floating(4 * rtt[node].p99()), state_period.load());
+    return state_period.load() + std::max<seconds_floating>(state_margin, margin);
+}
+
+// 链路预算中固定任务的序号，按 plan_link 中添加的顺序
+constexpr size_t
+    control_task  = 0,
+    odometry_task = 1,
+    state_task    = 2,
+    command_task  = 3;
+
+constexpr auto
+    query_bytes = sizeof(autolabor::can::pack_no_data),
+    reply_bytes = sizeof(autolabor::can::pack_with_data);
+
+void chassis::plan_link() {
+    std::lock_guard<decltype(budget_mutex)> lock(budget_mutex);
+    // 控制节拍：舵轮位置查询，应答到达后立即发出三帧控制指令
+    budget.add({link_priority_t::control,
+                rudder_interval, rudder_interval,
+                query_bytes + 3 * reply_bytes, reply_bytes});
+    budget.add({link_priority_t::odometry,
+                odometry_interval, 4 * odometry_interval,
+                query_bytes, 2 * reply_bytes});
+    budget.add({link_priority_t::status,
+                state_interval, 3 * state_interval,
+                2 * query_bytes, 5 * reply_bytes});
+    // 固定频率的控制指令，跟随舵轮应答时为空
+    budget.add({link_priority_t::control,
+                rudder_interval, rudder_interval,
+                0, 0});
+    apply_budget();
+}
+
+void chassis::update_poll(size_t index, std::chrono::milliseconds period) {
+    // 停止的查询保留任务，字节数置 0
+    const auto active = period.count() > 0;
+    const auto task   = link_task_t{link_priority_t::status,
+                                    active ? period : state_interval,
+                                    active ? 4 * period : state_interval,
+                                    active ? query_bytes : 0,
+                                    active ? reply_bytes : 0};
+    if (index < poll_tasks.size())
+        budget.update(poll_tasks[index], task);
+    else
+        poll_tasks.push_back(budget.add(task));
+    apply_budget();
+}
+
+void chassis::apply_budget() {
+    odometry_period = budget.period(odometry_task);
+    state_period    = budget.period(state_task);
+    for (size_t i = 0; i < poll_tasks.size(); ++i)
+        polls.set_actual_period(i, budget.period(poll_tasks[i]));
+    
+    std::lock_guard<decltype(link_mutex)> lock(link_mutex);
+    _link.planned_utilisation = budget.utilisation();
+    _link.odometry_period     = duration_seconds(odometry_period.load());
+    _link.state_period        = duration_seconds(state_period.load());
+}
+
 //==============================================================
 
 void chassis::set_enabled_target(bool state) {
@@ -341,17 +541,157 @@ void chassis::set_enabled_target(bool state) {
 }
 
 void chassis::set_target(double speed, double rudder) {
-    std::lock_guard<decltype(target_mutex)> l1(target_mutex);
-    
-    request_time = now();
-    target       = {static_cast<float>(speed), static_cast<float>(rudder)};
+    physical target{static_cast<float>(speed), static_cast<float>(rudder)};
     limit_in_velocity(&target, max_v, max_w, &config);
     limit_in_physical(&target, max_wheel_speed);
+    commands.write({target, now()});
+}
+
+void chassis::stop() {
+    std::lock_guard<decltype(stop_mutex)> l1(stop_mutex);
+    
+    halted    = true;
+    stop_time = now();
+    if (command_enabled)
+        port << pack_value<ecu<0>::target_speed, int>(0)
+             << pack_value<ecu<1>::target_speed, int>(0);
 }
 
 void chassis::reset_rudder() {
+    std::lock_guard<decltype(stop_mutex)> l1(stop_mutex);
+    
     port << autolabor::can::pack<tcu<0>::encoder_reset>();
-    target.rudder = 0;
+    reset_time = now();
+}
+
+void chassis::control_cycle(decltype(now()) _now,
+                            decltype(now() - now()) period,
+                            decltype(now() - now()) half) {
+    stamped_t<motor_t> sample{};
+    rudder_samples.read(sample);
+    if (sample.time == decltype(now()){}) return;
+    
+    const auto value = static_cast<float>(sample.value.position);
+    const auto age   = _now - sample.time;
+    
+    std::lock_guard<decltype(stop_mutex)> _lk(stop_mutex);
+    if (halted) {
+        halted        = false;
+        control_speed = 0;
+    }
+    
+    // 统计实际控制频率和舵轮读数过时（至少丢了一次应答）的周期
+    if (rate_window == decltype(now()){}) rate_window = _now;
+    ++cycle_count;
+    if (age > 2 * rudder_interval) ++stale_count;
+    if (_now - rate_window >= traffic_interval) {
+        std::lock_guard<decltype(link_mutex)> lock(link_mutex);
+        _link.control_rate        = cycle_count / duration_seconds(_now - rate_window);
+        _link.stale_rudder_cycles = stale_count;
+        rate_window = _now;
+        cycle_count = 0;
+    }
+    
+    // 三种来源写同一个信箱，后写者生效：
+    // 直接设置的目标在周期之间写入，到期的定时控制量在本周期覆盖它，路径跟随最后写入，优先级最高
+    
+    // 到期的定时控制量在离生效时刻最近的周期发出，暂停时保持转角、速度为零
+    physical scheduled{};
+    if (schedule.take(_now + half, scheduled))
+        set_target(paused ? 0 : scheduled.speed, scheduled.rudder);
+    // 路径跟随使用本周期最新的里程计，未在跟随时不推算位姿；
+    // 暂停时不推进路径跟随，由 set_paused 停车，恢复后接着跟随
+    physical followed{};
+    if (!paused && path.is_active() && path.step(_odometry.value().value, config, followed))
+        set_target(followed.speed, followed.rudder);
+    
+    command_t command{{0, NAN}, {}};
+    commands.read(command);
+    auto target = command.target;
+    // 急停和舵轮归零之前写入的控制量不再生效，之后写入的照常执行
+    if (command.time <= stop_time) target.speed = 0;
+    if (command.time <= reset_time) target.rudder = 0;
+    // 舵轮长时间没有应答时不再按旧读数行驶
+    if (std::isnan(target.rudder) || now() - command.time > control_timeout || age > control_timeout)
+        target = {0, value};
+    
+    // 读数到达时已经过时约半个往返，控制帧还要半个往返才到达，
+    // 按转动速度外推读数的年龄加一个往返，且不越过上一周期发出的目标；
+    // 固定频率的控制节拍总是外推，因为读数的年龄在周期之间变化
+    auto predicted = value;
+    if ((predict_rudder || control_rate.load() > 0) && !std::isnan(sent_rudder)) {
+        const auto lead = static_cast<float>(sample.value.speed * (duration_seconds(age) + rtt[2].p50()));
+        predicted = sent_rudder > value
+                    ? std::min(value + std::max(0.0f, lead), sent_rudder)
+                    : std::max(value + std::min(0.0f, lead), sent_rudder);
+    }
+    
+    auto optimized = optimize(target, {control_speed, predicted},
+                              optimize_width, acceleration * duration_seconds<float>(period));
+    control_speed = optimized.speed;
+    
+    auto wheels = physical_to_wheels(optimized, &config);
+    auto left   = PULSES_OF(wheels.left, default_wheel_k);
+    auto right  = PULSES_OF(wheels.right, default_wheel_k);
+    auto rudder = static_cast<short>(PULSES_OF(target.rudder, default_rudder_k));
+    sent_rudder = command_enabled ? target.rudder : NAN;
+    
+    if (command_enabled)
+        port << pack_value<ecu<0>::target_speed, int>(left)
+             << pack_value<ecu<1>::target_speed, int>(right)
+             << pack_value<tcu<0>::target_position, short>(rudder);
+}
+
+void chassis::set_control_rate(double rate) {
+    {
+        std::lock_guard<decltype(control_mutex)> lock(control_mutex);
+        control_rate = rate > 0 ? rate : 0;
+    }
+    {
+        std::lock_guard<decltype(budget_mutex)> lock(budget_mutex);
+        // 固定频率时查询和控制指令分开计入预算
+        const auto period = rate > 0
+                            ? std::max(1ms, std::chrono::milliseconds(static_cast<long>(1000 / rate)))
+                            : rudder_interval;
+        budget.update(control_task,
+                      {link_priority_t::control,
+                       rudder_interval, rudder_interval,
+                       query_bytes + (rate > 0 ? 0 : 3 * reply_bytes), reply_bytes});
+        budget.update(command_task,
+                      {link_priority_t::control,
+                       period, period,
+                       rate > 0 ? 3 * reply_bytes : 0, 0});
+        apply_budget();
+    }
+    control_signal.notify_all();
+}
+
+void chassis::start_control_loop() {
+    control_thread = std::thread([this] {
+        auto next = now();
+        
+        while (running) {
+            std::unique_lock<decltype(control_mutex)> _lk(control_mutex);
+            const auto rate = control_rate.load();
+            if (rate == 0) {
+                // 跟随舵轮应答，等待设置控制频率
+                control_signal.wait_for(_lk, 100ms, [this] { return !running || control_rate.load() > 0; });
+                next = now();
+                continue;
+            }
+            
+            // 按绝对时刻推进，不累积误差；落后超过一个周期时重新对齐，不补发
+            const auto period = std::chrono::duration_cast<decltype(now() - now())>(seconds_floating(1 / rate));
+            next += period;
+            const auto _now = now();
+            if (next < _now) next = _now;
+            if (control_signal.wait_until(_lk, next, [this, rate] { return !running || control_rate.load() != rate; }))
+                continue;
+            _lk.unlock();
+            
+            control_cycle(now(), period, period / 2);
+        }
+    });
 }
 
 void chassis::start_write_loop() {
@@ -359,9 +699,13 @@ void chassis::start_write_loop() {
         using t = decltype(now());
     
         differentiator_t<t>
-            odometry_time{{}, [](const t &t0, const t &t1) { return t1 - t0 > odometry_interval; }},
+            odometry_time{{}, [this](const t &t0, const t &t1) { return t1 - t0 > odometry_period.load(); }},
             rudder_time{{}, [](const t &t0, const t &t1) { return t1 - t0 > rudder_interval; }},
-            state_time{{}, [](const t &t0, const t &t1) { return t1 - t0 > state_interval; }};
+            state_time{{}, [this](const t &t0, const t &t1) { return t1 - t0 > state_period.load(); }},
+            traffic_time{{}, [](const t &t0, const t &t1) { return t1 - t0 > traffic_interval; }};
+        
+        auto sent     = port.bytes_sent(),
+             received = port.bytes_received();
     
         std::mutex lock;
         
@@ -369,17 +713,40 @@ void chassis::start_write_loop() {
             auto _now = now();
             t    _;
     
-            if (odometry_time.update(_now, _))
+            if (odometry_time.update(_now, _)) {
+                rtt[0].sent(position_query, now());
+                rtt[1].sent(position_query, now());
                 _odometry.ask(port);
+            }
     
-            if (rudder_time.update(_now, _))
+            if (rudder_time.update(_now, _)) {
+                rtt[2].sent(position_query, now());
                 port << autolabor::can::pack<tcu<0>::current_position_tx>();
+            }
     
             if (state_time.update(_now, _)) {
+                const auto time = now();
+                for (auto &tracker : rtt) tracker.sent(state_query, time);
+                rtt[3].sent(battery_query, time);
                 port << autolabor::can::pack<unit<>::state_tx>()
                      << autolabor::can::pack<vcu<>::battery_percent_tx>();
                 AVOID_SLEEP;
             }
+            
+            t last;
+            polls.tick(_now, port);
+            
+            if (traffic_time.update(_now, last) && last != t{}) {
+                const auto _sent     = port.bytes_sent(),
+                           _received = port.bytes_received();
+                const auto capacity  = budget.bytes_per_second() * duration_seconds(_now - last);
+                const auto measured  = std::max(_sent - sent, _received - received) / capacity;
+                sent     = _sent;
+                received = _received;
+                
+                std::lock_guard<decltype(link_mutex)> _lk(link_mutex);
+                _link.utilisation = measured;
+            }
     
             std::unique_lock<decltype(lock)> _lk(lock);
             if (synchronizer.wait_for(_lk, delay_interval, [this] { return !running; }))
@@ -389,7 +756,35 @@ void chassis::start_write_loop() {
 }
 
 void chassis::stop_all() {
-    running = false;
+    {
+        std::lock_guard<decltype(control_mutex)> lock(control_mutex);
+        running = false;
+    }
     synchronizer.notify_all();
+    control_signal.notify_all();
     port.break_read();
 }
+
+bool chassis::reconnect() {
+    const auto begin = now();
+    do {
+        std::this_thread::sleep_for(reconnect_interval);
+        try {
+            port.reopen(find_port(port.name(), hardware_id));
+        } catch (...) {
+            continue;
+        }
+        // 适配器重新枚举时节点不掉电，里程计和参数原样保留，只需恢复超时设置
+        port << can::pack<ecu<>::timeout>({2, 0});
+        update_latency_timer();
+        
+        const auto outage = duration_seconds(now() - begin);
+        std::lock_guard<decltype(link_mutex)> lock(link_mutex);
+        ++_link.reconnect_count;
+        _link.last_outage = outage;
+        _link.max_outage  = std::max(_link.max_outage, outage);
+        _link.total_outage += outage;
+        return true;
+    } while (running && now() - begin < reconnect_timeout);
+    return false;
+}
@@ -12,12 +12,19 @@
 
 #include "can_define.h"
 #include "pm1_odometry_t.hh"
+#include "link_budget_t.hh"
+#include "poll_registry_t.hh"
+#include "command_schedule_t.hh"
+#include "path_follower_t.hh"
 
+#include <pm1_sdk_definitions.h>
+#include <utilities/mailbox_t.hpp>
 #include <utilities/odometry_t.hpp>
 
 #include <utilities/serial_port/serial_port.hh>
 #include <utilities/time/time_extensions.h>
 #include <utilities/time/matcher_t.hpp>
+#include <utilities/time/rtt_tracker_t.hpp>
 
 extern "C" {
 #include "control_model/model.h"
@@ -25,6 +32,44 @@ extern "C" {
 
 namespace autolabor {
     namespace pm1 {
+        /** 连接统计 */
+        struct link_stats_t {
+            unsigned int reconnect_count; // 自动重连成功次数
+            double       last_outage,     // 最近一次断线时长（秒）
+                         max_outage,      // 最长断线时长（秒）
+                         total_outage;    // 累计断线时长（秒）
+            int          latency_timer,   // 适配器接收延迟定时器（毫秒），-1 表示不支持
+                         original_latency_timer; // 调整前的定时器（毫秒），-1 表示未调整
+            double       planned_utilisation,    // 按轮询计划估算的链路占用率
+                         utilisation,            // 最近一秒实测的链路占用率，收发两个方向中较大者
+                         odometry_period,        // 降频后的里程计查询周期（秒）
+                         state_period,           // 降频后的状态查询周期（秒）
+                         control_rate;           // 最近一秒实测的控制频率（Hz）
+            unsigned long long stale_rudder_cycles; // 舵轮读数过时（至少丢了一次应答）的控制周期数
+        };
+        
+        /** 遥测快照，各项取自同一时刻 */
+        struct telemetry_snapshot_t {
+            unsigned long long      seq;             // 快照序号，进程内所有底盘共用，只增不减
+            decltype(now())         time;            // 最后一次更新的时间
+            odometry_t<>            odometry;        // 里程计
+            motor_t                 left,            // 左轮状态
+                                    right,           // 右轮状态
+                                    rudder;          // 舵轮状态
+            chassis_state_t         state;           // 节点状态
+            double                  battery_percent; // 电池电量
+        };
+        
+        class chassis;
+        
+        /**
+         * 遥测更新观察者
+         *
+         * 在读线程中调用，参数为发布快照的底盘、更新后的快照和发生变化的项目（topic 位掩码）；
+         * 延迟推算位姿时应从发布快照的底盘补全位姿，全局底盘指针可能已指向别的底盘
+         */
+        using telemetry_observer_t = void (*)(const chassis &, const telemetry_snapshot_t &, unsigned int);
+        
         /** 底盘 */
         class chassis final {
         public:
@@ -32,6 +77,7 @@ namespace autolabor {
             const static float
                 default_optimize_width,
                 default_acceleration,
+                default_jerk,
                 default_max_v,
                 default_max_w,
                 default_max_wheel_speed;
@@ -44,6 +90,7 @@ namespace autolabor {
             volatile float
                 optimize_width,
                 acceleration,
+                jerk,
                 max_v,
                 max_w,
                 max_wheel_speed;
@@ -51,9 +98,32 @@ namespace autolabor {
             /** 是否向底盘发送控制指令 */
             volatile bool
                 command_enabled;
+            
+            /** 串口断开后是否自动重连 */
+            volatile bool
+                auto_reconnect;
+            
+            /** 是否按舵轮延迟预测转角，再按预测值限制速度 */
+            volatile bool
+                predict_rudder;
+            
+            /** 遥测更新观察者 */
+            std::atomic<telemetry_observer_t>
+                observer{nullptr};
     
-            /** 构造器 */
-            explicit chassis(const std::string &port_name);
+            /**
+             * 构造器
+             *
+             * @param port_name   串口名字
+             * @param baud_rate   波特率
+             * @param low_latency 是否以低延迟模式打开串口（按帧唤醒读线程），
+             *                    并把 USB 转串口适配器的接收延迟定时器调到 1 ms，析构时恢复
+             * @param cancel      置位时放弃检查节点，构造失败；用于并行探测时结束落选的串口
+             */
+            explicit chassis(const std::string &port_name,
+                             unsigned int baud_rate = 115200,
+                             bool low_latency = false,
+                             const std::atomic<bool> *cancel = nullptr);
             
             /** 析构 */
             ~chassis();
@@ -82,25 +152,141 @@ namespace autolabor {
             /** 读取里程计 */
             stamped_t<odometry_t<>> odometry() const;
             
+            /**
+             * 设置是否延迟推算位姿
+             *
+             * 延迟时读线程只记录编码器增量，读取里程计时才推算；
+             * 推送的遥测快照不含最新位姿，由读取者通过 odometry() 补全
+             */
+            void set_lazy_odometry(bool);
+            
+            /** 是否延迟推算位姿 */
+            bool is_odometry_lazy() const;
+            
+            /** 设置是否把两轮读数插值到同一时刻再配对 */
+            void set_wheel_interpolation(bool);
+            
             /** 读取电池电量 */
             double battery_percent() const;
             
             /** 线程是否正常运行 */
             bool is_threads_running() const;
             
+            /** 连接统计 */
+            link_stats_t link_stats() const;
+            
+            /** 节点往返时间统计，节点序号：[ecu0|ecu1|tcu|vcu] */
+            rtt_stats_t rtt_stats(size_t node) const;
+            
+            /** 由往返时间推算的节点状态超时，节点序号：[ecu0|ecu1|tcu|vcu] */
+            seconds_floating node_timeout(size_t node) const;
+            
+            /** 读取遥测快照 */
+            telemetry_snapshot_t telemetry() const;
+            
             /** 设置使能目标 */
             void set_enabled_target(bool);
             
             /** 设置目标控制量 */
             void set_target(double speed, double rudder);
             
+            /**
+             * 立即停车
+             *
+             * 不等待控制周期，在调用线程上直接发出零速度帧，舵轮目标保持不变
+             */
+            void stop();
+            
             /** 重设舵轮零位 */
             void reset_rudder();
+            
+            /**
+             * 设置控制频率
+             *
+             * @param rate 控制频率（Hz），为 0 时控制节拍跟随舵轮应答；
+             *             否则由独立线程按固定频率发出控制指令，丢失个别应答时照常运行，
+             *             舵轮转角按读数的年龄和往返时间外推
+             */
+            void set_control_rate(double rate);
+            
+            /**
+             * 周期查询
+             *
+             * @tparam tx    查询帧类型，如 vcu<0>::battery_voltage_tx
+             * @param period 查询周期，为 0 时停止；链路繁忙时按低优先级降频
+             */
+            template<class tx>
+            void poll(std::chrono::milliseconds period) {
+                // 登记与预算在同一把锁内完成，登记表序号与预算任务一一对应
+                std::lock_guard<decltype(budget_mutex)> lock(budget_mutex);
+                update_poll(polls.poll<tx>(period), period);
+            }
+            
+            /** 周期查询得到的最近一次应答 */
+            template<class tx>
+            stamped_t<poll_registry_t::data_t> polled() const {
+                return polls.latest<tx>();
+            }
+            
+            /** 定时控制量，由控制节拍在离生效时刻最近的周期发出 */
+            command_schedule_t schedule;
+            
+            /** 暂停标记，暂停期间定时控制量照常按时出队，但只发出零速度 */
+            std::atomic<bool> paused{false};
+            
+            /** 路径跟随，由控制节拍以最新的里程计计算目标控制量 */
+            path_follower_t path;
         
         private:
             /** 串口引用 */
             serial_port port;
             
+            /** 串口硬件标识，用于重连时找回改名的设备 */
+            std::string hardware_id;
+            
+            /** 是否调低适配器的接收延迟定时器 */
+            bool tune_latency;
+            
+            /** 调整并记录接收延迟定时器，打开和重连串口后调用 */
+            void update_latency_timer();
+            
+            /** 连接统计 */
+            link_stats_t _link{};
+            
+            /** 连接统计锁 */
+            mutable std::mutex link_mutex;
+            
+            /** 询问种类 */
+            enum query_t : size_t { position_query, state_query, battery_query };
+            
+            /** 各节点往返时间：[ecu0|ecu1|tcu|vcu] */
+            std::array<rtt_tracker_t<3>, 4> rtt;
+            
+            /** 链路预算 */
+            link_budget_t budget;
+            
+            /** 链路预算锁 */
+            std::mutex budget_mutex;
+            
+            /** 按链路预算规划的查询周期 */
+            std::atomic<std::chrono::milliseconds> odometry_period,
+                                                   state_period;
+            
+            /** 周期查询登记表 */
+            poll_registry_t polls;
+            
+            /** 登记表条目在链路预算中的任务序号 */
+            std::vector<size_t> poll_tasks;
+            
+            /** 规划查询周期，启动查询线程前调用 */
+            void plan_link();
+            
+            /** 更新周期查询的链路预算并重新规划，调用时持有预算锁 */
+            void update_poll(size_t index, std::chrono::milliseconds period);
+            
+            /** 按链路预算刷新各任务的实际周期，调用时持有预算锁 */
+            void apply_budget();
+            
             /** 节点状态 */
             chassis_state_t chassis_state{};
             
@@ -113,6 +299,22 @@ namespace autolabor {
             /** 电池电量 */
             uint8_t _battery = 0;
             
+            /** 遥测快照 */
+            telemetry_snapshot_t _telemetry{};
+            
+            /** 遥测快照锁 */
+            mutable std::mutex telemetry_mutex;
+            
+            /** 快照序号，所有底盘共用，重新连接后也不会回退 */
+            static std::atomic<unsigned long long> telemetry_seq;
+            
+            /** 快照中里程计和舵轮数据的时间 */
+            decltype(now()) odometry_time{},
+                            rudder_time{};
+            
+            /** 更新遥测快照，有变化时通知观察者 */
+            void publish(decltype(now()));
+            
             /** 底层线程是否运行 */
             std::atomic<bool> running;
     
@@ -121,25 +323,72 @@ namespace autolabor {
     
             /** 线程资源 */
             std::thread read_thread,
-                        write_thread;
+                        write_thread,
+                        control_thread;
     
             /** 启动查询线程 */
             void start_write_loop();
+            
+            /** 启动固定频率的控制线程 */
+            void start_control_loop();
     
             /** 终止任务 */
             void stop_all();
             
-            /** 目标设定锁 */
-            std::mutex target_mutex;
+            /** 断线重连，超时返回 false */
+            bool reconnect();
+            
+            /** 控制量设定 */
+            struct command_t {
+                physical        target;
+                decltype(now()) time; // 请求时间
+            };
+            
+            /** 控制量信箱，任意线程写入，读线程每个控制周期取一次 */
+            mailbox_t<command_t> commands;
+            
+            /** 急停锁，保证急停帧之后不会再发出旧的速度 */
+            std::mutex stop_mutex;
+            
+            /** 已直接发出零速度，速度规划从零重新开始 */
+            bool halted = false;
             
-            /** 目标运动 */
-            physical target{};
+            /** 最近一次急停和舵轮归零的时刻，由急停锁保护；早于它们的控制量按零速度或零转角执行 */
+            decltype(now()) stop_time{},
+                            reset_time{};
+            
+            /** 舵轮最新读数，读线程写入，控制节拍读取 */
+            mailbox_t<stamped_t<motor_t>> rudder_samples;
+            
+            /** 控制频率（Hz），0 表示跟随舵轮应答；在控制线程锁内修改，控制周期可以直接读取 */
+            std::atomic<double> control_rate{0};
+            
+            /** 控制线程锁和同步器，控制频率变化和终止时唤醒控制线程 */
+            std::mutex              control_mutex;
+            std::condition_variable control_signal;
+            
+            /** 上一个控制周期发出的速度和舵轮目标，由急停锁保护 */
+            float control_speed = 0,
+                  sent_rudder   = NAN;
+            
+            /** 控制频率统计，由急停锁保护 */
+            decltype(now())    rate_window{};
+            unsigned long      cycle_count = 0;
+            unsigned long long stale_count = 0;
+            
+            /**
+             * 控制周期
+             *
+             * @param time   当前时刻
+             * @param period 名义周期，用于速度规划
+             * @param half   定时控制量的提前量
+             */
+            void control_cycle(decltype(now()) time,
+                               decltype(now() - now()) period,
+                               decltype(now() - now()) half);
             
             /** 使能目标状态 */
             bool enabled_target;
-            
-            /** 最后一次请求的时间 */
-            decltype(now()) request_time;
         };
     }
 }
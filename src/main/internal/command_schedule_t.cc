@@ -0,0 +1,42 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "command_schedule_t.hh"
+
+#include <algorithm>
+
+using namespace autolabor::pm1;
+
+void command_schedule_t::replace_tail(std::vector<entry_t> entries) {
+    if (entries.empty()) return;
+    
+    const auto earlier = [](const entry_t &a, const entry_t &b) { return a.time < b.time; };
+    std::stable_sort(entries.begin(), entries.end(), earlier);
+    
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    queue.erase(std::lower_bound(queue.begin(), queue.end(), entries.front(), earlier), queue.end());
+    queue.insert(queue.end(), entries.begin(), entries.end());
+}
+
+void command_schedule_t::clear() {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    queue.clear();
+}
+
+size_t command_schedule_t::size() const {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    return queue.size();
+}
+
+bool command_schedule_t::take(time_t deadline, physical &target) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    if (queue.empty() || queue.front().time > deadline)
+        return false;
+    
+    const auto end = std::upper_bound(queue.begin(), queue.end(), deadline,
+                                      [](time_t time, const entry_t &entry) { return time < entry.time; });
+    target = std::prev(end)->target;
+    queue.erase(queue.begin(), end);
+    return true;
+}
@@ -0,0 +1,71 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_COMMAND_SCHEDULE_T_HH
+#define PM1_SDK_COMMAND_SCHEDULE_T_HH
+
+
+#include <mutex>
+#include <vector>
+
+#include <utilities/time/time_extensions.h>
+
+extern "C" {
+#include "control_model/model.h"
+}
+
+namespace autolabor {
+    namespace pm1 {
+        /**
+         * 定时控制量队列
+         * 线程安全
+         *
+         * 规划线程按时间写入未来的控制量，控制节拍每个周期取出到期的一条；
+         * 重新规划时整体替换队尾，不会残留旧规划的控制量
+         */
+        class command_schedule_t {
+        public:
+            using time_t = decltype(now());
+            
+            /** 定时控制量 */
+            struct entry_t {
+                time_t   time;   // 生效时刻
+                physical target; // 目标控制量
+            };
+            
+            /**
+             * 替换队尾
+             *
+             * 删除生效时刻不早于 entries 中最早时刻的全部控制量，再按时间顺序插入 entries；
+             * entries 为空时不做任何修改
+             */
+            void replace_tail(std::vector<entry_t> entries);
+            
+            /** 清空 */
+            void clear();
+            
+            /** 队列长度 */
+            size_t size() const;
+            
+            /**
+             * 取出到期的控制量
+             *
+             * 生效时刻不晚于 deadline 的控制量全部出队，只返回其中最后一条，
+             * 来不及执行的旧控制量被跳过
+             *
+             * @param deadline 截止时刻，通常为当前时刻加半个控制周期，使控制量在离生效时刻最近的周期发出
+             * @param target   [out] 到期的控制量
+             * @return 是否有到期的控制量
+             */
+            bool take(time_t deadline, physical &target);
+        
+        private:
+            mutable std::mutex   mutex;
+            std::vector<entry_t> queue; // 按生效时刻升序
+        };
+    } // namespace pm1
+} // namespace autolabor
+
+
+#endif //PM1_SDK_COMMAND_SCHEDULE_T_HH
@@ -0,0 +1,126 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "jerk_profile_t.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace autolabor;
+
+jerk_profile_t::jerk_profile_t(double peak, double acceleration, double jerk, double keep)
+    : _peak(peak), _jerk(jerk), t_keep(keep) {
+    // 峰值速度不足以达到最大加速度时没有匀加速段
+    if (peak * jerk >= acceleration * acceleration) {
+        t_jerk = acceleration / jerk;
+        t_flat = peak / acceleration - t_jerk;
+    } else {
+        t_jerk = std::sqrt(peak / jerk);
+        t_flat = 0;
+    }
+    t_ramp = 2 * t_jerk + t_flat;
+    s_ramp = peak * t_ramp / 2;
+}
+
+jerk_profile_t
+jerk_profile_t::of_distance(double distance,
+                            double speed,
+                            double acceleration,
+                            double jerk) {
+    distance = std::max(.0, distance);
+    speed    = std::abs(speed);
+    
+    // 加速到 v 再减速到静止的最短距离：
+    // v >= a²/j 时为 v (v/a + a/j)，否则为 2 v √(v/j)
+    const auto corner = acceleration * acceleration / jerk;
+    const auto least  = [=](double v) {
+        return v >= corner
+               ? v * (v / acceleration + acceleration / jerk)
+               : 2 * v * std::sqrt(v / jerk);
+    };
+    
+    if (least(speed) <= distance)
+        return {speed, acceleration, jerk, (distance - least(speed)) / speed};
+    // 距离不足以加速到最大速度，取恰好走完距离的峰值速度
+    if (least(corner) <= distance) {
+        const auto b = acceleration * acceleration / jerk;
+        return {(std::sqrt(b * b + 4 * acceleration * distance) - b) / 2, acceleration, jerk, 0};
+    }
+    return {std::cbrt(distance * distance * jerk / 4), acceleration, jerk, 0};
+}
+
+jerk_profile_t
+jerk_profile_t::of_duration(double duration,
+                            double speed,
+                            double acceleration,
+                            double jerk) {
+    duration = std::max(.0, duration);
+    speed    = std::abs(speed);
+    
+    // 加速到 v 的时间：v >= a²/j 时为 v/a + a/j，否则为 2 √(v/j)
+    const auto ramp = speed >= acceleration * acceleration / jerk
+                      ? speed / acceleration + acceleration / jerk
+                      : 2 * std::sqrt(speed / jerk);
+    if (2 * ramp <= duration)
+        return {speed, acceleration, jerk, duration - 2 * ramp};
+    // 时间不足以加速到最大速度，加速段和减速段各占一半
+    const auto half = duration / 2;
+    if (half >= 2 * acceleration / jerk)
+        return {acceleration * (half - acceleration / jerk), acceleration, jerk, 0};
+    return {jerk * half * half / 4, acceleration, jerk, 0};
+}
+
+double jerk_profile_t::ramp_speed(double time) const {
+    if (time <= 0)
+        return 0;
+    if (time <= t_jerk)
+        return _jerk * time * time / 2;
+    if (time <= t_jerk + t_flat)
+        return _jerk * t_jerk * (time - t_jerk / 2);
+    if (time < t_ramp) {
+        const auto rest = t_ramp - time;
+        return _peak - _jerk * rest * rest / 2;
+    }
+    return _peak;
+}
+
+double jerk_profile_t::ramp_position(double time) const {
+    if (time <= 0)
+        return 0;
+    if (time <= t_jerk)
+        return _jerk * time * time * time / 6;
+    if (time <= t_jerk + t_flat) {
+        const auto a = _jerk * t_jerk;
+        return a * t_jerk * t_jerk / 6 + a * time * (time - t_jerk) / 2;
+    }
+    if (time < t_ramp) {
+        const auto rest = t_ramp - time;
+        return s_ramp - _peak * rest + _jerk * rest * rest * rest / 6;
+    }
+    return s_ramp + _peak * (time - t_ramp);
+}
+
+double jerk_profile_t::speed(double time) const {
+    return time < t_ramp + t_keep
+           ? ramp_speed(time)
+           : ramp_speed(duration() - time);
+}
+
+double jerk_profile_t::position(double time) const {
+    return time < t_ramp + t_keep
+           ? ramp_position(time)
+           : distance() - ramp_position(duration() - time);
+}
+
+double jerk_profile_t::peak() const {
+    return _peak;
+}
+
+double jerk_profile_t::duration() const {
+    return 2 * t_ramp + t_keep;
+}
+
+double jerk_profile_t::distance() const {
+    return 2 * s_ramp + _peak * t_keep;
+}
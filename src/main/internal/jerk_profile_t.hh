@@ -0,0 +1,80 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_JERK_PROFILE_T_HH
+#define PM1_SDK_JERK_PROFILE_T_HH
+
+
+namespace autolabor {
+    /**
+     * 加加速度受限的 S 形速度曲线
+     *
+     * 从静止加速到峰值速度、匀速巡航、再对称地减速到静止；
+     * 加速段依次为加加速度上升、匀加速、加加速度下降，
+     * 各段的速度和位移都是时间的多项式，按时间闭式求值，不做逐步积分
+     */
+    class jerk_profile_t {
+    public:
+        /**
+         * 以最短时间走完给定距离的曲线
+         *
+         * @param distance     距离
+         * @param speed        最大速度
+         * @param acceleration 最大加速度
+         * @param jerk         最大加加速度
+         */
+        static jerk_profile_t of_distance(double distance,
+                                          double speed,
+                                          double acceleration,
+                                          double jerk);
+        
+        /**
+         * 恰好持续给定时间的曲线，时间不足以加速到最大速度时降低峰值速度
+         *
+         * @param duration     持续时间
+         * @param speed        最大速度
+         * @param acceleration 最大加速度
+         * @param jerk         最大加加速度
+         */
+        static jerk_profile_t of_duration(double duration,
+                                          double speed,
+                                          double acceleration,
+                                          double jerk);
+        
+        /** 起步后 time 时刻的速度 */
+        double speed(double time) const;
+        
+        /** 起步后 time 时刻的位移 */
+        double position(double time) const;
+        
+        /** 峰值速度 */
+        double peak() const;
+        
+        /** 总时间 */
+        double duration() const;
+        
+        /** 总距离 */
+        double distance() const;
+    
+    private:
+        double _peak,  // 峰值速度
+               _jerk,  // 加加速度
+               t_jerk, // 加加速度上升（下降）段时长
+               t_flat, // 匀加速段时长
+               t_ramp, // 加速段时长
+               t_keep, // 匀速段时长
+               s_ramp; // 加速段距离
+        
+        jerk_profile_t(double peak, double acceleration, double jerk, double keep);
+        
+        /** 加速段 time 时刻的速度 */
+        double ramp_speed(double time) const;
+        
+        /** 加速段 time 时刻的位移 */
+        double ramp_position(double time) const;
+    };
+}
+
+
+#endif //PM1_SDK_JERK_PROFILE_T_HH
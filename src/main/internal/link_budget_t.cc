@@ -0,0 +1,101 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "link_budget_t.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace autolabor::pm1;
+
+/** 周期取整的粒度，与写线程的节拍对齐 */
+constexpr auto period_step = std::chrono::milliseconds(10);
+
+link_budget_t::link_budget_t(unsigned int baud_rate, double limit)
+    : capacity(baud_rate / 10.0),
+      limit(limit) {}
+
+size_t link_budget_t::add(const link_task_t &task) {
+    tasks.push_back(task);
+    periods.push_back(task.period);
+    plan();
+    return tasks.size() - 1;
+}
+
+void link_budget_t::update(size_t index, const link_task_t &task) {
+    tasks.at(index) = task;
+    plan();
+}
+
+std::chrono::milliseconds link_budget_t::period(size_t index) const {
+    return periods.at(index);
+}
+
+double link_budget_t::tx_utilisation() const {
+    double sum = 0;
+    for (auto priority : {link_priority_t::control, link_priority_t::odometry, link_priority_t::status})
+        sum += load(priority).first;
+    return sum / capacity;
+}
+
+double link_budget_t::rx_utilisation() const {
+    double sum = 0;
+    for (auto priority : {link_priority_t::control, link_priority_t::odometry, link_priority_t::status})
+        sum += load(priority).second;
+    return sum / capacity;
+}
+
+double link_budget_t::utilisation() const {
+    return std::max(tx_utilisation(), rx_utilisation());
+}
+
+double link_budget_t::bytes_per_second() const {
+    return capacity;
+}
+
+std::pair<double, double> link_budget_t::load(link_priority_t priority) const {
+    std::pair<double, double> result{0, 0};
+    for (size_t i = 0; i < tasks.size(); ++i)
+        if (tasks[i].priority == priority) {
+            const auto frequency = 1000.0 / periods[i].count();
+            result.first += tasks[i].tx_bytes * frequency;
+            result.second += tasks[i].rx_bytes * frequency;
+        }
+    return result;
+}
+
+void link_budget_t::plan() {
+    for (size_t i = 0; i < tasks.size(); ++i)
+        periods[i] = tasks[i].period;
+    
+    // 从最低优先级开始降频，每一级按同一比例拉长周期
+    for (auto priority : {link_priority_t::status, link_priority_t::odometry}) {
+        if (utilisation() <= limit) return;
+        
+        const auto own   = load(priority);
+        const auto total = std::make_pair(tx_utilisation() * capacity, rx_utilisation() * capacity);
+        const auto room  = limit * capacity;
+        
+        // 本级需要缩减到的比例，其他任务已占满上限时按最长周期处理
+        auto scale = 1.0;
+        if (own.first > 0)
+            scale = std::max(scale, room > total.first - own.first
+                                    ? own.first / (room - (total.first - own.first))
+                                    : INFINITY);
+        if (own.second > 0)
+            scale = std::max(scale, room > total.second - own.second
+                                    ? own.second / (room - (total.second - own.second))
+                                    : INFINITY);
+        
+        for (size_t i = 0; i < tasks.size(); ++i)
+            if (tasks[i].priority == priority) {
+                const auto stretched = std::isinf(scale)
+                                       ? tasks[i].max_period.count()
+                                       : std::ceil(tasks[i].period.count() * scale / period_step.count())
+                                         * period_step.count();
+                periods[i] = std::min(tasks[i].max_period,
+                                      std::chrono::milliseconds(static_cast<long long>(stretched)));
+            }
+    }
+}
@@ -0,0 +1,90 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_LINK_BUDGET_T_HH
+#define PM1_SDK_LINK_BUDGET_T_HH
+
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autolabor {
+    namespace pm1 {
+        /** 周期任务的优先级，数值越小越重要 */
+        enum class link_priority_t : uint8_t {
+            control,  // 控制节拍，永不降频
+            odometry, // 里程计
+            status,   // 状态、电量等低频查询
+        };
+        
+        /** 链路上的周期任务 */
+        struct link_task_t {
+            link_priority_t           priority;   // 优先级
+            std::chrono::milliseconds period,     // 期望周期
+                                      max_period; // 降频后允许的最长周期
+            size_t                    tx_bytes,   // 每周期发送的字节数
+                                      rx_bytes;   // 每周期接收的字节数
+        };
+        
+        /**
+         * 串口链路预算
+         * 非线程安全
+         *
+         * 按波特率和全部周期任务估算收发两个方向的占用率；
+         * 超过上限时从最低优先级开始拉长任务周期，直到占用率回到上限以内或达到最长周期，
+         * 控制节拍始终保持期望周期
+         */
+        class link_budget_t {
+        public:
+            /**
+             * 构造器
+             *
+             * @param baud_rate 波特率，按 8N1 每字节 10 位计算
+             * @param limit     占用率上限
+             */
+            explicit link_budget_t(unsigned int baud_rate, double limit = 0.8);
+            
+            /**
+             * 添加周期任务并重新规划
+             *
+             * @return 任务序号
+             */
+            size_t add(const link_task_t &task);
+            
+            /** 修改周期任务并重新规划，停用的任务把字节数置 0 */
+            void update(size_t index, const link_task_t &task);
+            
+            /** 规划后的任务周期 */
+            std::chrono::milliseconds period(size_t index) const;
+            
+            /** 规划后的发送方向占用率 */
+            double tx_utilisation() const;
+            
+            /** 规划后的接收方向占用率 */
+            double rx_utilisation() const;
+            
+            /** 规划后的链路占用率，取两个方向中较大者 */
+            double utilisation() const;
+            
+            /** 每秒能传输的字节数 */
+            double bytes_per_second() const;
+        
+        private:
+            double                                 capacity, limit;
+            std::vector<link_task_t>               tasks;
+            std::vector<std::chrono::milliseconds> periods;
+            
+            /** 按当前周期计算某一优先级的字节率：发送、接收 */
+            std::pair<double, double> load(link_priority_t priority) const;
+            
+            /** 重新规划所有任务的周期 */
+            void plan();
+        };
+    } // namespace pm1
+} // namespace autolabor
+
+
+#endif //PM1_SDK_LINK_BUDGET_T_HH
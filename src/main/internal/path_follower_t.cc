@@ -0,0 +1,165 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "path_follower_t.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace autolabor::pm1;
+
+/** 到达终点的判定距离（m） */
+constexpr double goal_tolerance = 0.02;
+
+/** 接近终点时的最低速度比例 */
+constexpr double min_speed_ratio = 0.2;
+
+bool path_follower_t::start(const point_t *_points, size_t _count, double _speed, double _lookahead) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    
+    head      = 0;
+    size      = std::min(_count, capacity);
+    speed     = _speed;
+    lookahead = _lookahead;
+    active    = size > 0;
+    std::copy(_points, _points + size, points.begin());
+    
+    count    = 0;
+    last     = square = max = 0;
+    residual = NAN;
+    return size == _count;
+}
+
+size_t path_follower_t::append(const point_t *_points, size_t _count) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    
+    const auto accepted = std::min(_count, capacity - size);
+    for (size_t i = 0; i < accepted; ++i)
+        points[(head + size++) % capacity] = _points[i];
+    if (accepted && speed > 0) active = true;
+    return accepted;
+}
+
+bool path_follower_t::clear() {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    const auto result = active;
+    head   = size = 0;
+    speed  = 0;
+    active = false;
+    return result;
+}
+
+path_follower_t::stats_t path_follower_t::stats() const {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    return {count, last, count ? std::sqrt(square / count) : 0, max, residual, size, active};
+}
+
+bool path_follower_t::is_active() const {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    return active;
+}
+
+const path_follower_t::point_t &path_follower_t::at(size_t i) const {
+    return points[(head + i) % capacity];
+}
+
+bool path_follower_t::step(const odometry_t<> &pose, const chassis_config_t &config, physical &target) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    if (!active) return false;
+    
+    // 机器人在路段 [a, b] 上的投影参数
+    const auto project = [&](const point_t &a, const point_t &b) {
+        const auto dx     = b.x - a.x,
+                   dy     = b.y - a.y,
+                   length = dx * dx + dy * dy;
+        return length > 0 ? ((pose.x - a.x) * dx + (pose.y - a.y) * dy) / length : 1;
+    };
+    // 机器人到路段 [a, b] 的距离，路段左侧为正
+    const auto distance = [&](const point_t &a, const point_t &b) {
+        const auto t    = std::max(.0, std::min(1.0, project(a, b))),
+                   side = (b.x - a.x) * (pose.y - a.y) - (b.y - a.y) * (pose.x - a.x);
+        return std::copysign(std::hypot(pose.x - a.x - (b.x - a.x) * t,
+                                        pose.y - a.y - (b.y - a.y) * t), side);
+    };
+    
+    // 出队投影已越过终点的路段，最后一段保留到终点
+    while (size > 2 && project(at(0), at(1)) >= 1) {
+        head = (head + 1) % capacity;
+        --size;
+    }
+    
+    // 投影点，只剩一个路点时直接驶向该点
+    point_t from{pose.x, pose.y};
+    size_t  next = 0;
+    if (size >= 2) {
+        const auto &a = at(0), &b = at(1);
+        const auto t  = std::max(.0, std::min(1.0, project(a, b)));
+        from = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t};
+        next = 1;
+    }
+    
+    // 沿路径前进前视距离找前视点，路径不够长时取终点
+    auto    rest = lookahead;
+    point_t goal = from;
+    for (; next < size; ++next) {
+        const auto &p   = at(next);
+        const auto step = std::hypot(p.x - goal.x, p.y - goal.y);
+        if (step >= rest) {
+            const auto k = rest / step;
+            goal = {goal.x + (p.x - goal.x) * k, goal.y + (p.y - goal.y) * k};
+            rest = 0;
+            break;
+        }
+        rest -= step;
+        goal = p;
+    }
+    const auto remaining = lookahead - rest; // 前视范围内剩余的路程
+    
+    // 横向误差取前视范围内最近的路段，在弯道内侧抄近路时投影所在的路段不一定最近
+    if (size >= 2) {
+        auto e = distance(at(0), at(1));
+        for (size_t i = 1; i < std::min(next, size - 1); ++i) {
+            const auto temp = distance(at(i), at(i + 1));
+            if (std::abs(temp) < std::abs(e)) e = temp;
+        }
+        last = e;
+        ++count;
+        square += e * e;
+        max = std::max(max, std::abs(e));
+    }
+    
+    // 到达终点，保留终点作为后续追加路段的起点；
+    // 剩余路程从投影点算起，偏离路径时投影可能已到终点而机器人还在旁边，须同时检查到终点的距离
+    const auto &end    = at(size - 1);
+    const auto distance_to_end = std::hypot(end.x - pose.x, end.y - pose.y);
+    const auto reached = rest > 0 && remaining <= goal_tolerance && distance_to_end <= goal_tolerance;
+    // 越过终点：投影已过最后一段的终点且终点在身后，横向冲出后继续追踪只会绕着终点打转
+    const auto passed  = size == 2
+                         && project(at(0), at(1)) >= 1
+                         && std::cos(pose.theta) * (end.x - pose.x) + std::sin(pose.theta) * (end.y - pose.y) < 0;
+    if (reached || passed) {
+        head     = (head + size - 1) % capacity;
+        size     = 1;
+        active   = false;
+        residual = distance_to_end;
+        target   = {0, NAN};
+        return true;
+    }
+    
+    // 前视点转到机器人坐标系，纯追踪曲率 2y / d²
+    const auto dx    = goal.x - pose.x,
+               dy    = goal.y - pose.y,
+               cos   = std::cos(pose.theta),
+               sin   = std::sin(pose.theta),
+               x     = cos * dx + sin * dy,
+               y     = -sin * dx + cos * dy,
+               d2    = x * x + y * y,
+               kappa = d2 > 0 ? 2 * y / d2 : 0;
+    // 接近终点时按剩余路程减速
+    const auto v = speed * std::max(min_speed_ratio, std::min(1.0, remaining / lookahead));
+    
+    // 后轮转向模型：曲率 κ 对应舵轮转角 -atan(length·κ)，由运动模型换算
+    target = velocity_to_physical({static_cast<float>(v), static_cast<float>(v * kappa)}, &config);
+    return true;
+}
@@ -0,0 +1,115 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_PATH_FOLLOWER_T_HH
+#define PM1_SDK_PATH_FOLLOWER_T_HH
+
+
+#include <array>
+#include <mutex>
+
+#include <utilities/odometry_t.hpp>
+
+extern "C" {
+#include "control_model/model.h"
+}
+
+namespace autolabor {
+    namespace pm1 {
+        /**
+         * 纯追踪路径跟随
+         * 线程安全，容量固定，控制周期内不分配内存
+         *
+         * 路点保存在定长环形缓冲区中，已经驶过的路段出队，腾出的空间可以继续追加路点；
+         * 每个控制周期以最新的里程计位姿在路径上找前视点，
+         * 按前视点求出行驶曲率，再由运动模型换算为舵轮转角和轮速；
+         * 到达终点，或在最后一段上越过终点（终点已在身后）时结束，不再绕回终点
+         */
+        class path_follower_t {
+        public:
+            /** 路点容量 */
+            constexpr static size_t capacity = 1024;
+            
+            /** 路点 */
+            struct point_t { double x, y; };
+            
+            /** 横向误差统计 */
+            struct stats_t {
+                unsigned long count;     // 样本数
+                double        last,      // 最近一次横向误差（m），左正右负
+                              rms,       // 均方根（m）
+                              max,       // 绝对值最大值（m）
+                              residual;  // 结束跟随时到终点的距离（m），尚未结束时为 NAN
+                size_t        waypoints; // 尚未驶过的路点数
+                bool          active;    // 是否正在跟随
+            };
+            
+            /**
+             * 替换路径并开始跟随
+             *
+             * 横向误差统计同时清零
+             *
+             * @param points    路点，至多 capacity 个
+             * @param count     路点数
+             * @param speed     线速度（m/s），必须为正
+             * @param lookahead 前视距离（m），必须为正
+             * @return 是否全部接受
+             */
+            bool start(const point_t *points, size_t count, double speed, double lookahead);
+            
+            /**
+             * 在路径末尾追加路点
+             *
+             * 已经到达终点时从当前位置接着跟随新路点
+             *
+             * @return 接受的路点数，缓冲区满时小于 count
+             */
+            size_t append(const point_t *points, size_t count);
+            
+            /**
+             * 停止跟随并清空路点
+             *
+             * @return 清空前是否正在跟随
+             */
+            bool clear();
+            
+            /** 统计 */
+            stats_t stats() const;
+            
+            /** 是否正在跟随 */
+            bool is_active() const;
+            
+            /**
+             * 计算本周期的目标控制量
+             *
+             * @param pose   最新的里程计位姿
+             * @param config 底盘结构参数
+             * @param target [out] 目标控制量，到达或越过终点时为停车
+             * @return 是否正在跟随，否则不修改 target
+             */
+            bool step(const odometry_t<> &pose, const chassis_config_t &config, physical &target);
+        
+        private:
+            mutable std::mutex            mutex;
+            std::array<point_t, capacity> points{};
+            size_t                        head      = 0, // 当前路段起点
+                                          size      = 0;
+            double                        speed     = 0,
+                                          lookahead = 0;
+            bool                          active    = false;
+            
+            unsigned long count  = 0;
+            double        last     = 0,
+                          square   = 0, // 横向误差平方和
+                          max      = 0,
+                          residual = NAN;
+            
+            /** 第 i 个尚未驶过的路点 */
+            const point_t &at(size_t i) const;
+        };
+    } // namespace pm1
+} // namespace autolabor
+
+
+#endif //PM1_SDK_PATH_FOLLOWER_T_HH
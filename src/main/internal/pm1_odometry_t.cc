@@ -1,4 +1,4 @@
-//
+﻿//
 // Created by User on 2019/7/25.
 //
 
@@ -42,9 +42,35 @@ autolabor::pm1::pm1_odometry_t::try_parse(
 autolabor::stamped_t<autolabor::odometry_t<>>
 autolabor::pm1::pm1_odometry_t::value() const {
     std::lock_guard<decltype(update_lock)> lock(update_lock);
+    materialize();
     return _odometry;
 }
 
+decltype(autolabor::now())
+autolabor::pm1::pm1_odometry_t::time() const {
+    return decltype(now())(decltype(now())::duration(paired.load()));
+}
+
+void
+autolabor::pm1::pm1_odometry_t::set_lazy(bool value) {
+    _lazy = value;
+}
+
+bool
+autolabor::pm1::pm1_odometry_t::lazy() const {
+    return _lazy;
+}
+
+void
+autolabor::pm1::pm1_odometry_t::set_interpolate(bool value) {
+    _interpolate = value;
+}
+
+bool
+autolabor::pm1::pm1_odometry_t::interpolate() const {
+    return _interpolate;
+}
+
 /**
  * 推算里程增量
  * @param left   左轮转角增量
@@ -73,6 +99,20 @@ wheels_to_odometry(
     return {std::abs(s), std::abs(a), x, y, a};
 }
 
+void
+autolabor::pm1::pm1_odometry_t::materialize() const {
+    const auto head = ring_head.load(std::memory_order_acquire);
+    auto       tail = ring_tail.load(std::memory_order_relaxed);
+    for (; tail != head; ++tail) {
+        const auto &ticks = ring[tail % capacity];
+        _odometry.value += wheels_to_odometry(ticks.left * static_cast<double>(default_wheel_k) / subdivision,
+                                              ticks.right * static_cast<double>(default_wheel_k) / subdivision,
+                                              paired_config);
+        _odometry.time = decltype(now())(decltype(now())::duration(ticks.time));
+    }
+    ring_tail.store(tail, std::memory_order_release);
+}
+
 void
 autolabor::pm1::pm1_odometry_t::update(
     bool left,
@@ -80,33 +120,73 @@ autolabor::pm1::pm1_odometry_t::update(
     const pack_with_data &msg,
     const chassis_config_t &config
 ) {
-    auto             &motor = left ? _left : _right;
-    decltype(l_mark) *mark,
-                     *other;
-    if (left) {
-        mark  = &l_mark;
-        other = &r_mark;
-    } else {
-        mark  = &r_mark;
-        other = &l_mark;
-    }
+    auto   &motor = left ? _left : _right;
+    auto   &mark  = left ? l_mark : r_mark,
+           &other = left ? r_mark : l_mark;
     
     const auto last     = motor;
-    const auto value    = RAD_OF(get_data_value<int>(msg), default_wheel_k);
+    const auto pulses   = get_data_value<int32_t>(msg);
+    const auto value    = RAD_OF(pulses, static_cast<double>(default_wheel_k));
     const auto sequence = wheels_seq.load();
     
-    motor = {_now, {value, value - last.value.position / duration_seconds(_now - last.time)}};
-    mark->seq = sequence;
+    motor = {_now, {value, (value - last.value.position) / duration_seconds(_now - last.time)}};
+    
+    // 脉冲数按 32 位回绕，差值取模后仍然正确
+    mark.previous = mark.position;
+    mark.last     = mark.time;
+    if (mark.valid)
+        mark.position += static_cast<int32_t>(static_cast<uint32_t>(pulses) - static_cast<uint32_t>(mark.raw));
+    else
+        mark.previous = mark.position = 0;
+    mark.raw   = pulses;
+    mark.time  = _now.time_since_epoch().count();
+    mark.seq   = sequence;
+    mark.valid = true;
     
-    if (sequence == 0 || other->seq == 0)
-        mark->last = value;
-    else if (other->seq == sequence) {
-        std::lock_guard<decltype(update_lock)> lock(update_lock);
-        _odometry.value += wheels_to_odometry(_left.value.position - l_mark.last,
-                                              _right.value.position - r_mark.last,
-                                              config);
-        _odometry.time = _now;
-        l_mark.last    = _left.value.position;
-        r_mark.last    = _right.value.position;
+    if (sequence == 0 || other.seq == 0)
+        mark.paired = mark.position * subdivision;
+    else if (other.seq == sequence) {
+        auto l    = l_mark.position * subdivision,
+             r    = r_mark.position * subdivision;
+        auto time = mark.time;
+        if (_interpolate) {
+            // 后应答的一轮在前后两次读数之间插值到先应答一轮的时刻
+            const auto &early = l_mark.time <= r_mark.time ? l_mark : r_mark;
+            const auto &late  = &early == &l_mark ? r_mark : l_mark;
+            if (late.last < early.time && early.time < late.time) {
+                const auto k     = static_cast<double>(early.time - late.last) / (late.time - late.last);
+                const auto value = late.previous * subdivision
+                                   + std::llround(k * (late.position - late.previous) * subdivision);
+                if (&late == &l_mark)
+                    l = value;
+                else
+                    r = value;
+            }
+            time = early.time;
+        }
+        const ticks_t ticks{static_cast<int32_t>(l - l_mark.paired),
+                            static_cast<int32_t>(r - r_mark.paired),
+                            time};
+        l_mark.paired = l;
+        r_mark.paired = r;
+        
+        const auto head = ring_head.load(std::memory_order_relaxed);
+        const auto same = config.width == paired_config.width
+                          && config.left_radius == paired_config.left_radius
+                          && config.right_radius == paired_config.right_radius;
+        // 环满或结构参数变化时先推算已有的增量
+        if (!same || head - ring_tail.load(std::memory_order_acquire) == capacity) {
+            std::lock_guard<decltype(update_lock)> lock(update_lock);
+            materialize();
+            paired_config = config;
+        }
+        ring[head % capacity] = ticks;
+        ring_head.store(head + 1, std::memory_order_release);
+        paired = time;
+        
+        if (!_lazy) {
+            std::lock_guard<decltype(update_lock)> lock(update_lock);
+            materialize();
+        }
     }
 }
@@ -6,6 +6,10 @@
 #define PM1_SDK_PM1_ODOMETRY_T_HH
 
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 #include <utilities/odometry_t.hpp>
 #include <utilities/serial_port/serial_port.hh>
 #include <utilities/time/stamped_t.h>
@@ -20,7 +24,16 @@ namespace autolabor {
         /** 电机信息 */
         struct motor_t { double position, speed; };
         
-        /** pm1 里程采集和计算 */
+        /**
+         * pm1 里程采集和计算
+         *
+         * 两轮应答配对后，读线程只把两轮的编码器增量（1/256 脉冲的整数）写入定长环；
+         * 即时模式下随即推算位姿，延迟模式下在读取位姿时从上次推算的位置接着推算，
+         * 环满时由读线程推算一次腾出空间。
+         * 增量以整数计算，编码器读数再大也不损失精度。
+         * 插值模式下后应答的一轮按前后两次读数线性插值到先应答一轮的时刻，
+         * 两轮位置对齐到同一时刻再求增量
+         */
         struct pm1_odometry_t {
             /** 解析结果 */
             enum class result_type : uint8_t { none, left, right };
@@ -41,8 +54,47 @@ namespace autolabor {
             
             /** 获取当前里程计 */
             stamped_t<odometry_t<>> value() const;
+            
+            /** 最后一次两轮配对的时刻，不推算位姿 */
+            decltype(now()) time() const;
+            
+            /** 设置是否延迟推算位姿 */
+            void set_lazy(bool);
+            
+            /** 是否延迟推算位姿 */
+            bool lazy() const;
+            
+            /** 设置是否把两轮读数插值到同一时刻 */
+            void set_interpolate(bool);
+            
+            /** 是否把两轮读数插值到同一时刻 */
+            bool interpolate() const;
         
         private:
+            /** 一次配对的编码器增量（1/256 脉冲）和配对时刻 */
+            struct ticks_t {
+                int32_t              left, right;
+                decltype(now())::rep time;
+            };
+            
+            /** 单轮读数记录，位置已展开 32 位回绕 */
+            struct mark_t {
+                unsigned long        seq;      // 读数对应的询问序号
+                int32_t              raw;      // 最近一次原始读数
+                int64_t              position, // 最近一次读数
+                                     previous, // 上一次读数
+                                     paired;   // 上次配对时的位置（1/256 脉冲）
+                decltype(now())::rep time,     // 最近一次读数的时刻
+                                     last;     // 上一次读数的时刻
+                bool                 valid;    // 已有读数
+            };
+            
+            /** 增量环容量，约 20 Hz 配对时可存 12.8 秒 */
+            constexpr static size_t capacity = 256;
+            
+            /** 增量的细分倍数 */
+            constexpr static int64_t subdivision = 256;
+            
             // 日志
             decltype(now()) origin;
             
@@ -51,23 +103,44 @@ namespace autolabor {
                 wheels_seq;
             
             // 电机更新信息记录
-            struct { unsigned long seq; double last; }
+            mark_t
                 l_mark{},
                 r_mark{};
             
-            // 里程计更新锁
+            // 里程计更新锁，推算位姿的线程持有
             mutable std::mutex
                 update_lock;
             
-            // 里程计缓存
-            stamped_t<odometry_t<>>
+            // 里程计缓存，推算到增量环的读位置
+            mutable stamped_t<odometry_t<>>
                 _odometry{};
             
+            // 增量环，读线程写入，推算位姿的线程读出
+            std::array<ticks_t, capacity>
+                ring{};
+            mutable std::atomic<size_t>
+                ring_head{0},
+                ring_tail{0};
+            
+            // 最后一次配对的时刻
+            std::atomic<decltype(now())::rep>
+                paired{0};
+            
+            // 增量环中的增量对应的结构参数，读线程在持有更新锁时修改
+            chassis_config_t
+                paired_config{};
+            std::atomic<bool>
+                _lazy{false},
+                _interpolate{false};
+            
             // 进行更新
             void update(bool left,
                         decltype(now()),
                         const pack_with_data &,
                         const chassis_config_t &);
+            
+            // 推算增量环中的全部增量，需持有更新锁
+            void materialize() const;
         };
     } // namespace pm1
 } // namespace autolabor
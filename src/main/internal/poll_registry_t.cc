@@ -0,0 +1,64 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "poll_registry_t.hh"
+
+using namespace autolabor::pm1;
+
+size_t poll_registry_t::set(const pack_no_data &query,
+                            match_t match,
+                            std::chrono::milliseconds period) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    for (size_t i = 0; i < entries.size(); ++i)
+        if (entries[i].match == match) {
+            entries[i].period = entries[i].actual = period;
+            entries[i].next   = now();
+            return i;
+        }
+    entries.push_back({query, match, period, period, now(), {}});
+    return entries.size() - 1;
+}
+
+autolabor::stamped_t<poll_registry_t::data_t>
+poll_registry_t::find(match_t match) const {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    for (const auto &entry : entries)
+        if (entry.match == match)
+            return entry.value;
+    return {};
+}
+
+void poll_registry_t::set_actual_period(size_t index, std::chrono::milliseconds period) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    auto &entry = entries.at(index);
+    if (entry.period.count() > 0) entry.actual = period;
+}
+
+void poll_registry_t::tick(decltype(now()) time, serial_port &port) {
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<decltype(mutex)> lock(mutex);
+        // 发出所有到期的查询，周期已由链路预算规划，不会超出带宽
+        for (auto &entry : entries) {
+            if (entry.actual.count() <= 0 || entry.next > time) continue;
+            
+            // 落后超过一个周期时不补发，从当前时刻重新计时
+            entry.next += entry.actual;
+            if (entry.next <= time) entry.next = time + entry.actual;
+            buffer.insert(buffer.end(), bytes_begin(entry.query), bytes_end(entry.query));
+        }
+    }
+    if (!buffer.empty()) port.send(buffer.data(), buffer.size());
+}
+
+bool poll_registry_t::parse(decltype(now()) time, const pack_with_data &msg) {
+    std::lock_guard<decltype(mutex)> lock(mutex);
+    for (auto &entry : entries)
+        if (entry.match(msg)) {
+            entry.value.time = time;
+            std::copy(msg.data, msg.data + sizeof(msg.data), entry.value.value.begin());
+            return true;
+        }
+    return false;
+}
@@ -0,0 +1,106 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_POLL_REGISTRY_T_HH
+#define PM1_SDK_POLL_REGISTRY_T_HH
+
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <utilities/serial_port/serial_port.hh>
+#include <utilities/time/stamped_t.h>
+#include "can_define.h"
+
+namespace autolabor {
+    namespace pm1 {
+        /**
+         * 周期查询登记表
+         * 线程安全
+         *
+         * 以查询帧类型登记，如 poll<vcu<0>::battery_voltage_tx>(1s)；
+         * 应答匹配函数按类型在编译期生成，解析时逐条比对，命中后保存带时间戳的数据域。
+         * 每个写线程节拍发出所有到期的查询，实际周期与登记（或降频后）的周期一致
+         */
+        class poll_registry_t {
+        public:
+            /** 应答数据域 */
+            using data_t = std::array<uint8_t, 8>;
+            
+            /**
+             * 登记查询或修改周期
+             *
+             * @tparam tx    查询帧类型
+             * @param period 查询周期，为 0 时停止查询，已收到的数据保留
+             * @return 条目序号，同一查询重复登记返回同一序号
+             */
+            template<class tx>
+            size_t poll(std::chrono::milliseconds period) {
+                static_assert(std::is_same<typename tx::type_t, pack_no_data>::value,
+                              "only query (tx) dialogs can be polled");
+                return set(pack<tx>(), &reply_match<tx>, period);
+            }
+            
+            /** 最近一次应答，未收到时时间戳为时钟起点 */
+            template<class tx>
+            stamped_t<data_t> latest() const {
+                return find(&reply_match<tx>);
+            }
+            
+            /** 最近一次应答，按数据类型解码 */
+            template<class tx, class value_t>
+            stamped_t<value_t> latest() const {
+                const auto raw = latest<tx>();
+                pack_with_data msg{};
+                std::copy(raw.value.begin(), raw.value.end(), msg.data);
+                return {raw.time, get_data_value<value_t>(msg)};
+            }
+            
+            /** 修改实际发送周期，用于链路预算降频，已停止的查询不受影响 */
+            void set_actual_period(size_t index, std::chrono::milliseconds period);
+            
+            /** 发送所有到期的查询 */
+            void tick(decltype(now()) time, serial_port &port);
+            
+            /**
+             * 解析应答
+             *
+             * @return 是否为登记的查询的应答
+             */
+            bool parse(decltype(now()) time, const pack_with_data &msg);
+        
+        private:
+            using match_t = bool (*)(const pack_with_data &);
+            
+            struct entry_t {
+                pack_no_data              query;
+                match_t                   match;
+                std::chrono::milliseconds period,  // 登记的周期
+                                          actual;  // 降频后的周期
+                decltype(now())           next;    // 下一次发送的时刻
+                stamped_t<data_t>         value;
+            };
+            
+            /** 应答匹配：节点类型和消息类型相同，广播查询接受任意序号的节点 */
+            template<class tx>
+            static bool reply_match(const pack_with_data &msg) {
+                return msg.node_type() == tx::node_type
+                       && msg.msg_type == tx::msg_type
+                       && (tx::node_index == any_controller::node_index || msg.node_index == tx::node_index);
+            }
+            
+            mutable std::mutex   mutex;
+            std::vector<entry_t> entries;
+            
+            size_t set(const pack_no_data &query, match_t match, std::chrono::milliseconds period);
+            
+            stamped_t<data_t> find(match_t match) const;
+        };
+    } // namespace pm1
+} // namespace autolabor
+
+
+#endif //PM1_SDK_POLL_REGISTRY_T_HH
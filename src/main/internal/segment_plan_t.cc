@@ -0,0 +1,83 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "segment_plan_t.hh"
+
+#include <cmath>
+
+using namespace autolabor::pm1;
+
+segment_plan_t::segment_plan_t(std::vector<segment_t> _segments,
+                               process_controller _controller,
+                               double optimize_width,
+                               double rudder_speed)
+    : segments(std::move(_segments)),
+      controller(_controller),
+      begins(segments.size() + 1, 0),
+      entries(segments.size(), 0),
+      exits(segments.size(), 0),
+      stops(segments.size(), true) {
+    const auto n = segments.size();
+    
+    // 段间衔接速度
+    std::vector<double> joints(n + 1, controller.speed_end);
+    for (size_t i = 0; i < n; ++i) {
+        begins[i + 1] = begins[i] + segments[i].length;
+        if (i == 0) continue;
+        
+        const auto &last = segments[i - 1].target,
+                   &next = segments[i].target;
+        const auto delta = std::abs(next.rudder - last.rudder);
+        if (last.speed * next.speed > 0 && delta < optimize_width) {
+            stops[i]  = false;
+            joints[i] = std::min(std::abs(last.speed), std::abs(next.speed)) * (1 - delta / optimize_width);
+            if (delta > 0) {
+                // 里程度量是两轮路程之和，速度是较快一轮的线速度，驶过的里程度量不超过速度的两倍
+                const auto slew = delta / rudder_speed;
+                joints[i] = std::min(joints[i], std::min(segments[i - 1].length, segments[i].length) / 4 / slew);
+            }
+        }
+    }
+    
+    // 后向：保证每个衔接点之前都来得及减速
+    auto limit = controller.speed_end;
+    for (size_t i = n; i-- > 0;) {
+        exits[i] = limit;
+        limit    = std::min(joints[i], limit + controller.deceleration * segments[i].length);
+    }
+    // 前向：衔接速度不超过上一段能加速到的速度
+    for (size_t i = 0; i < n; ++i)
+        entries[i] = stops[i]
+                     ? controller.speed_begin
+                     : std::min({joints[i],
+                                 static_cast<double>(std::abs(segments[i - 1].target.speed)),
+                                 entries[i - 1] + controller.acceleration * segments[i - 1].length});
+}
+
+size_t segment_plan_t::size() const {
+    return segments.size();
+}
+
+double segment_plan_t::length() const {
+    return begins.back();
+}
+
+double segment_plan_t::begin(size_t index) const {
+    return begins[index];
+}
+
+const physical &segment_plan_t::target(size_t index) const {
+    return segments[index].target;
+}
+
+bool segment_plan_t::stop_before(size_t index) const {
+    return stops[index];
+}
+
+double segment_plan_t::speed(size_t index, double x, double restart) const {
+    return std::min({static_cast<double>(std::abs(segments[index].target.speed)),
+                     entries[index] + controller.acceleration * std::max(.0, x - begins[index]),
+                     controller.speed_begin + controller.acceleration * std::max(.0, x - restart),
+                     exits[index] + controller.deceleration * std::max(.0, begins[index + 1] - x)});
+}
@@ -0,0 +1,86 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_SEGMENT_PLAN_T_HH
+#define PM1_SDK_SEGMENT_PLAN_T_HH
+
+
+#include <vector>
+
+#include "process_controller.hpp"
+
+extern "C" {
+#include "control_model/model.h"
+}
+
+namespace autolabor {
+    namespace pm1 {
+        /**
+         * 连续运动段的速度规划
+         * 非线程安全
+         *
+         * 各段首尾相接，位置以累计里程度量表示；
+         * 段间后轮转角变化小于优化宽度且行驶方向不变时平滑衔接，
+         * 衔接速度按转角变化折减，与底盘的转角优化一致，并保证后轮转动期间驶过的里程不超过相邻段较短者的一半；
+         * 否则在段间停车，等后轮转到位再起步。
+         * 速度上限由前向的加速约束和后向的减速约束共同决定，只在最后一段的终点停车
+         */
+        class segment_plan_t {
+        public:
+            /** 运动段 */
+            struct segment_t {
+                physical target; // 目标控制量
+                double   length; // 里程度量
+            };
+            
+            /**
+             * 构造
+             *
+             * @param segments       运动段
+             * @param controller     过程控制器，提供起步、终止速度和加减速度
+             * @param optimize_width 底盘转角优化宽度
+             * @param rudder_speed   后轮转向速度（rad/s）
+             */
+            segment_plan_t(std::vector<segment_t> segments,
+                           process_controller controller,
+                           double optimize_width,
+                           double rudder_speed);
+            
+            /** 段数 */
+            size_t size() const;
+            
+            /** 总里程度量 */
+            double length() const;
+            
+            /** 第 index 段起点的累计里程度量，index 等于段数时为总里程度量 */
+            double begin(size_t index) const;
+            
+            /** 第 index 段的目标控制量 */
+            const physical &target(size_t index) const;
+            
+            /** 进入第 index 段前是否需要停车 */
+            bool stop_before(size_t index) const;
+            
+            /**
+             * 速度上限（绝对值）
+             *
+             * @param index   当前段
+             * @param x       累计里程度量
+             * @param restart 最近一次起步（包括暂停后恢复）的累计里程度量
+             */
+            double speed(size_t index, double x, double restart) const;
+        
+        private:
+            std::vector<segment_t> segments;
+            process_controller     controller;
+            std::vector<double>    begins,  // 各段起点，末尾为总里程度量
+                                   entries, // 进入各段时的速度上限（前向）
+                                   exits;   // 离开各段时的速度上限（后向）
+            std::vector<bool>      stops;   // 进入各段前是否停车
+        };
+    } // namespace pm1
+} // namespace autolabor
+
+
+#endif //PM1_SDK_SEGMENT_PLAN_T_HH
@@ -6,7 +6,10 @@
 #include "pm1_sdk_native.h"
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 
 #include "utilities/serial_port/serial.h"
 #include "utilities/time/time_extensions.h"
@@ -15,10 +18,36 @@ namespace autolabor {
     namespace pm1 {
         autolabor::pm1::result<void>
         on_native(autolabor::pm1::native::handler_t handler) {
+            // 成功时不读取、不移除异常信息，也不构造字符串
+            if (!native::get_error_code(handler)) return {};
             auto error = std::string(native::get_error_info(handler));
             native::remove_error_info(handler);
             return {error};
         }
+        
+        autolabor::pm1::telemetry
+        from_native(const native::telemetry_t &temp) {
+            return {temp.seq, temp.stamp,
+                    temp.s, temp.a,
+                    temp.x, temp.y, temp.theta,
+                    {temp.left_position, temp.left_speed},
+                    {temp.right_position, temp.right_speed},
+                    {temp.rudder_position, temp.rudder_speed},
+                    {static_cast<chassis_state>(temp.states[0]),
+                     static_cast<chassis_state>(temp.states[1]),
+                     static_cast<chassis_state>(temp.states[2]),
+                     static_cast<chassis_state>(temp.states[3])},
+                    temp.battery_percent};
+        }
+        
+        /** 订阅号到回调对象的映射，回调对象在取消订阅后释放 */
+        std::unordered_map<unsigned int, std::unique_ptr<telemetry_callback>> callbacks;
+        std::mutex                                                           callbacks_mutex;
+        
+        void STD_CALL
+        on_telemetry(const native::telemetry_t *temp, unsigned int topics, void *user) {
+            (*static_cast<telemetry_callback *>(user))(from_native(*temp), topics);
+        }
     }
 }
 
@@ -33,9 +62,19 @@ std::vector<std::string> autolabor::pm1::serial_ports() {
 autolabor::pm1::result<std::string>
 autolabor::pm1::initialize(const std::string &port,
                            double *progress) {
+    return initialize_ex(port, 115200, false, progress);
+}
+
+autolabor::pm1::result<std::string>
+autolabor::pm1::initialize_ex(const std::string &port,
+                              unsigned int baud_rate,
+                              bool low_latency,
+                              double *progress) {
     double _progress;
-    auto   handler = native::initialize(port.c_str(),
-                                        progress ? *progress : _progress);
+    auto   handler = native::initialize_ex(port.c_str(),
+                                           baud_rate,
+                                           low_latency,
+                                           progress ? *progress : _progress);
     auto   error   = std::string(native::get_error_info(handler));
     native::remove_error_info(handler);
     
@@ -47,6 +86,30 @@ autolabor::pm1::shutdown() {
     return on_native(native::shutdown());
 }
 
+autolabor::pm1::result<void>
+autolabor::pm1::set_auto_reconnect(bool enabled) {
+    return on_native(native::set_auto_reconnect(enabled));
+}
+
+autolabor::pm1::result<autolabor::pm1::connection_info>
+autolabor::pm1::get_connection_info() {
+    native::connection_info_t info{};
+    auto result = on_native(native::get_connection_info(info));
+    return {result.error_info,
+            {info.reconnect_count,
+             info.last_outage,
+             info.max_outage,
+             info.total_outage,
+             info.latency_timer,
+             info.original_latency_timer,
+             info.planned_utilisation,
+             info.utilisation,
+             info.odometry_period,
+             info.state_period,
+             info.control_rate,
+             info.stale_rudder_cycles}};
+}
+
 double
 autolabor::pm1::get_default_parameter(autolabor::pm1::parameter_id id) {
     return native::get_default_parameter(static_cast<native::handler_t>(id));
@@ -80,11 +143,91 @@ autolabor::pm1::get_odometry() {
     double   _;
     odometry temp{};
     
-    auto handler = native::get_odometry(_, _, _,
-                                        temp.x, temp.y, temp.yaw);
-    auto error   = std::string(native::get_error_info(handler));
-    native::remove_error_info(handler);
-    return {error, temp};
+    auto result = on_native(native::get_odometry(_, _, _,
+                                                 temp.x, temp.y, temp.yaw));
+    return {std::move(result.error_info), temp};
+}
+
+autolabor::pm1::result<autolabor::pm1::telemetry>
+autolabor::pm1::get_telemetry() {
+    native::telemetry_t temp{};
+    
+    auto result = on_native(native::get_telemetry(temp));
+    return {std::move(result.error_info), from_native(temp)};
+}
+
+autolabor::pm1::result<autolabor::pm1::rtt_stats>
+autolabor::pm1::get_rtt_stats(unsigned int node) {
+    native::rtt_stats_t temp{};
+    
+    auto result = on_native(native::get_rtt_stats(node, temp));
+    return {std::move(result.error_info),
+            {temp.samples,
+             temp.lost,
+             temp.min,
+             temp.avg,
+             temp.p99,
+             temp.timeout,
+             temp.max_rate}};
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::set_poll_period(dialog_id target, double period) {
+    return on_native(native::set_poll_period(static_cast<unsigned int>(target), period));
+}
+
+autolabor::pm1::result<autolabor::pm1::polled>
+autolabor::pm1::get_polled(dialog_id target) {
+    native::polled_t temp{};
+    
+    auto   result = on_native(native::get_polled(static_cast<unsigned int>(target), temp));
+    polled value{temp.stamp, {}};
+    std::copy(std::begin(temp.data), std::end(temp.data), value.data.begin());
+    return {std::move(result.error_info), value};
+}
+
+autolabor::pm1::result<autolabor::pm1::telemetry>
+autolabor::pm1::wait_telemetry(unsigned int topics,
+                               unsigned long long after_seq,
+                               double timeout) {
+    native::telemetry_t temp{};
+    
+    auto result = on_native(native::wait_telemetry(topics, after_seq, timeout, temp));
+    return {std::move(result.error_info), from_native(temp)};
+}
+
+autolabor::pm1::result<autolabor::pm1::telemetry>
+autolabor::pm1::wait_odometry(unsigned long long after_seq, double timeout) {
+    return wait_telemetry(static_cast<unsigned int>(topic::odometry), after_seq, timeout);
+}
+
+autolabor::pm1::result<autolabor::pm1::telemetry>
+autolabor::pm1::wait_state(unsigned long long after_seq, double timeout) {
+    return wait_telemetry(static_cast<unsigned int>(topic::state), after_seq, timeout);
+}
+
+autolabor::pm1::result<unsigned int>
+autolabor::pm1::subscribe(unsigned int topics,
+                          telemetry_callback callback,
+                          unsigned int decimation) {
+    auto         function     = std::make_unique<telemetry_callback>(std::move(callback));
+    unsigned int subscription = 0;
+    
+    std::lock_guard<decltype(callbacks_mutex)> lock(callbacks_mutex);
+    auto result = on_native(native::subscribe(topics, decimation, on_telemetry, function.get(), subscription));
+    if (result)
+        callbacks[subscription] = std::move(function);
+    return {std::move(result.error_info), subscription};
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::unsubscribe(unsigned int subscription) {
+    auto result = on_native(native::unsubscribe(subscription));
+    if (result) {
+        std::lock_guard<decltype(callbacks_mutex)> lock(callbacks_mutex);
+        callbacks.erase(subscription);
+    }
+    return result;
 }
 
 autolabor::pm1::result<void>
@@ -131,6 +274,78 @@ autolabor::pm1::drive(double v, double w) {
     return on_native(native::drive_velocity(v, w));
 }
 
+autolabor::pm1::result<void>
+autolabor::pm1::schedule_velocity(const std::vector<timed_velocity> &commands) {
+    std::vector<native::timed_command_t> temp;
+    temp.reserve(commands.size());
+    for (const auto &command : commands)
+        temp.push_back({command.stamp, command.v, command.w});
+    return on_native(native::schedule_velocity(temp.data(), static_cast<unsigned int>(temp.size())));
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::schedule_physical(const std::vector<timed_physical> &commands) {
+    std::vector<native::timed_command_t> temp;
+    temp.reserve(commands.size());
+    for (const auto &command : commands)
+        temp.push_back({command.stamp, command.speed, command.rudder});
+    return on_native(native::schedule_physical(temp.data(), static_cast<unsigned int>(temp.size())));
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::clear_schedule() {
+    return on_native(native::clear_schedule());
+}
+
+/** 转换路点 */
+inline std::vector<autolabor::pm1::native::waypoint_t>
+to_native(const std::vector<autolabor::pm1::waypoint> &points) {
+    std::vector<autolabor::pm1::native::waypoint_t> temp;
+    temp.reserve(points.size());
+    for (const auto &point : points)
+        temp.push_back({point.x, point.y});
+    return temp;
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::set_control_rate(double rate) {
+    return on_native(native::set_control_rate(rate));
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::follow_path(const std::vector<waypoint> &points,
+                            double speed,
+                            double lookahead) {
+    const auto temp = to_native(points);
+    return on_native(native::follow_path(temp.data(), static_cast<unsigned int>(temp.size()), speed, lookahead));
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::append_path(const std::vector<waypoint> &points) {
+    const auto temp = to_native(points);
+    return on_native(native::append_path(temp.data(), static_cast<unsigned int>(temp.size())));
+}
+
+autolabor::pm1::result<void>
+autolabor::pm1::clear_path() {
+    return on_native(native::clear_path());
+}
+
+autolabor::pm1::result<autolabor::pm1::path_stats>
+autolabor::pm1::get_path_stats() {
+    native::path_stats_t temp{};
+    
+    auto result = on_native(native::get_path_stats(temp));
+    return {std::move(result.error_info),
+            {temp.samples,
+             temp.last,
+             temp.rms,
+             temp.max,
+             temp.residual,
+             temp.waypoints,
+             temp.active}};
+}
+
 constexpr auto
     infinite_action = "action never complete",
     negative_target = "action target argument must be positive";
@@ -329,6 +544,19 @@ autolabor::pm1::drive_spatial(double v,
                               progress ? *progress : _progress));
 }
 
+autolabor::pm1::result<void>
+autolabor::pm1::drive_segments(const std::vector<segment> &segments,
+                               double *progress) {
+    std::vector<native::segment_t> temp;
+    temp.reserve(segments.size());
+    for (const auto &segment : segments)
+        temp.push_back({segment.v, segment.w, segment.spatium, segment.angle});
+    double _progress;
+    return on_native(
+        native::drive_segments(temp.data(), static_cast<unsigned int>(temp.size()),
+                               progress ? *progress : _progress));
+}
+
 autolabor::pm1::result<void>
 autolabor::pm1::drive_timing(double v,
                              double w,
@@ -11,6 +11,8 @@
 #define DLL_EXPORT
 #endif // _MSC_VER
 
+#include <array>
+#include <functional>
 #include <string>
 #include <vector>
 #include "pm1_sdk_definitions.h"
@@ -72,6 +74,111 @@ namespace autolabor {
          */
         struct odometry { double x, y, yaw; };
         
+        /**
+         * 电机状态
+         */
+        struct motor_state { double position, speed; };
+        
+        /**
+         * 遥测信息，所有字段取自同一时刻
+         */
+        struct telemetry {
+            unsigned long long seq;             // 快照序号
+            double             stamp;           // 时间戳（秒）
+            double             s, a;            // 路程、转角
+            double             x, y, yaw;       // 位姿
+            motor_state        left,            // 左轮
+                               right,           // 右轮
+                               rudder;          // 后轮方向
+            chassis_state      states[4];       // 节点状态：[ecu0|ecu1|tcu|vcu]
+            double             battery_percent; // 电池电量
+        };
+        
+        /**
+         * 连接信息
+         */
+        struct connection_info {
+            unsigned int reconnect_count; // 自动重连成功次数
+            double       last_outage,     // 最近一次断线时长（秒）
+                         max_outage,      // 最长断线时长（秒）
+                         total_outage;    // 累计断线时长（秒）
+            int          latency_timer,   // 适配器接收延迟定时器（毫秒），-1 表示不支持
+                         original_latency_timer; // 调整前的定时器（毫秒），-1 表示未调整
+            double       planned_utilisation,    // 按轮询计划估算的链路占用率
+                         utilisation,            // 最近一秒实测的链路占用率，收发两个方向中较大者
+                         odometry_period,        // 降频后的里程计查询周期（秒）
+                         state_period,           // 降频后的状态查询周期（秒）
+                         control_rate;           // 最近一秒实测的控制频率（Hz）
+            unsigned long long stale_rudder_cycles; // 舵轮读数过时（至少丢了一次应答）的控制周期数
+        };
+        
+        /**
+         * 节点往返时间统计
+         */
+        struct rtt_stats {
+            unsigned long long samples,  // 累计配对成功的应答数
+                               lost;     // 累计未得到应答的询问数
+            double             min,      // 最近 128 次应答的最短往返时间（秒）
+                               avg,      // 最近 128 次应答的平均往返时间（秒）
+                               p99,      // 最近 128 次应答的 99% 分位往返时间（秒）
+                               timeout,  // 由往返时间推算的节点状态超时（秒）
+                               max_rate; // 应答不与下一次询问交叠的最高询问频率（Hz），无样本时为 0
+        };
+        
+        /**
+         * 路点，坐标与 get_odometry 同系
+         */
+        struct waypoint { double x, y; };
+        
+        /**
+         * 路径跟随状态
+         */
+        struct path_stats {
+            unsigned long long samples;   // 横向误差样本数
+            double             last,      // 最近一次横向误差（m），路径左侧为正
+                               rms,       // 横向误差均方根（m）
+                               max,       // 横向误差绝对值最大值（m）
+                               residual;  // 结束跟随时到终点的距离（m），尚未结束时为 NAN
+            unsigned int       waypoints; // 尚未驶过的路点数
+            bool               active;    // 是否正在跟随
+        };
+        
+        /**
+         * 按运动模型描述的定时控制量
+         */
+        struct timed_velocity {
+            double stamp, // 生效时刻（秒），与遥测时间戳同源
+                   v,     // 线速度
+                   w;     // 角速度
+        };
+        
+        /**
+         * 按物理模型描述的定时控制量
+         */
+        struct timed_physical {
+            double stamp,  // 生效时刻（秒），与遥测时间戳同源
+                   speed,  // 轮速
+                   rudder; // 舵轮转角
+        };
+        
+        /**
+         * 运动段，参数同 drive_spatial
+         */
+        struct segment {
+            double v,       // 线速度
+                   w,       // 角速度
+                   spatium, // 路程约束
+                   angle;   // 转角约束
+        };
+        
+        /**
+         * 周期查询得到的应答
+         */
+        struct polled {
+            double                       stamp; // 应答到达的时间戳（秒），未收到时为 0
+            std::array<unsigned char, 8> data;  // 应答数据域
+        };
+        
         /**
          * 初始化
          *
@@ -82,12 +189,44 @@ namespace autolabor {
         initialize(const std::string &port = "",
                    double *progress = nullptr);
         
+        /**
+         * 以指定串口设置初始化
+         *
+         * @param port        串口名字，为空则自动探测
+         * @param baud_rate   波特率，非标准值按任意波特率设置
+         * @param low_latency 低延迟模式：请求驱动关闭接收缓冲延迟，并按帧唤醒读线程，
+         *                    USB 转串口适配器支持时把接收延迟定时器调到 1 ms（关闭时恢复），
+         *                    缩短从帧到达到回调、等待返回的延迟
+         * @param progress    进度
+         */
+        DLL_EXPORT result<std::string>
+        initialize_ex(const std::string &port,
+                      unsigned int baud_rate,
+                      bool low_latency,
+                      double *progress = nullptr);
+        
         /**
          * 关闭
          */
         DLL_EXPORT result<void>
         shutdown();
         
+        /**
+         * 开关断线自动重连
+         *
+         * @param enabled 是否自动重连
+         */
+        DLL_EXPORT result<void>
+        set_auto_reconnect(bool enabled);
+        
+        /**
+         * 获取连接信息
+         *
+         * @return 重连次数和断线时长
+         */
+        DLL_EXPORT result<connection_info>
+        get_connection_info();
+        
         /**
          * 获取底盘参数默认值
          *
@@ -131,6 +270,109 @@ namespace autolabor {
         DLL_EXPORT result<odometry>
         get_odometry();
         
+        /**
+         * 读取遥测快照
+         *
+         * @return 遥测信息或异常信息
+         */
+        DLL_EXPORT result<telemetry>
+        get_telemetry();
+        
+        /**
+         * 读取节点往返时间统计
+         *
+         * 用于在控制出现停顿之前发现响应慢的适配器
+         *
+         * @param node 节点序号：[ecu0|ecu1|tcu|vcu]
+         * @return 往返时间统计或异常信息
+         */
+        DLL_EXPORT result<rtt_stats>
+        get_rtt_stats(unsigned int node);
+        
+        /**
+         * 设置对话的查询周期
+         *
+         * 查询在写线程的节拍中逐条错开发送，链路繁忙时与状态查询一同降频
+         *
+         * @param target 对话
+         * @param period 查询周期（秒），不大于 0 时停止查询
+         * @return 是否成功
+         */
+        DLL_EXPORT result<void>
+        set_poll_period(dialog_id target, double period);
+        
+        /**
+         * 读取周期查询得到的最近一次应答
+         *
+         * @param target 对话
+         * @return 应答或异常信息
+         */
+        DLL_EXPORT result<polled>
+        get_polled(dialog_id target);
+        
+        /**
+         * 等待新的遥测数据
+         *
+         * 阻塞到 topics 中任一项目在序号 after_seq 之后更新；
+         * 把返回的 seq 作为下一次的 after_seq，不会重复取得同一次更新。
+         * 只保存最新的快照，两次调用之间发生的多次更新只能取得最后一次，
+         * 需要逐个处理时请检查 seq 是否连续，或改用 subscribe
+         *
+         * @param topics    等待的项目，topic 的位组合
+         * @param after_seq 已经取得的快照序号，0 表示取得任意一次更新
+         * @param timeout   超时时间（秒），超过约 3 年（含无穷大）按 3 年计，NaN 与负值按 0 计
+         * @return 遥测信息或异常信息
+         */
+        DLL_EXPORT result<telemetry>
+        wait_telemetry(unsigned int topics,
+                       unsigned long long after_seq,
+                       double timeout);
+        
+        /**
+         * 等待新的里程计数据
+         */
+        DLL_EXPORT result<telemetry>
+        wait_odometry(unsigned long long after_seq, double timeout);
+        
+        /**
+         * 等待节点状态变化
+         */
+        DLL_EXPORT result<telemetry>
+        wait_state(unsigned long long after_seq, double timeout);
+        
+        /**
+         * 遥测订阅回调，参数为更新后的快照和本次变化的项目（topic 位掩码）
+         */
+        using telemetry_callback = std::function<void(const telemetry &, unsigned int)>;
+        
+        /**
+         * 订阅遥测更新
+         *
+         * 回调在 SDK 的串口读线程中、帧解析完成后立即调用，
+         * 延迟只包含串口传输和解析，不包含轮询周期；
+         * 里程计约 20 Hz，后轮方向角约 50 Hz，节点状态和电量至多 1 Hz 变化。
+         * 回调阻塞时不会解析新的帧，也不会发送控制指令，因此必须尽快返回，
+         * 且不能在回调中调用 initialize 或 shutdown
+         *
+         * @param topics     订阅的项目，topic 的位组合
+         * @param callback   回调函数
+         * @param decimation 抽取倍数，每 decimation 次更新回调一次
+         * @return 订阅号或异常信息
+         */
+        DLL_EXPORT result<unsigned int>
+        subscribe(unsigned int topics,
+                  telemetry_callback callback,
+                  unsigned int decimation = 1);
+        
+        /**
+         * 取消订阅，返回后回调不会再被调用
+         * 不能在回调中调用
+         *
+         * @param subscription 订阅号
+         */
+        DLL_EXPORT result<void>
+        unsubscribe(unsigned int subscription);
+        
         /**
          * 清除里程计累计值
          */
@@ -193,6 +435,70 @@ namespace autolabor {
         DLL_EXPORT result<void>
         drive(double v, double w);
         
+        /**
+         * 按运动模型安排定时控制量
+         *
+         * 每条控制量在离生效时刻最近的控制周期发出，不受调用线程调度抖动影响；
+         * 队列中不早于本批最早时刻的控制量先被删除，重新规划时传入新的队尾即可；
+         * 暂停期间速度为零，cancel_action 清空队列
+         *
+         * @param commands 控制量，不要求有序
+         */
+        DLL_EXPORT result<void>
+        schedule_velocity(const std::vector<timed_velocity> &commands);
+        
+        /**
+         * 按物理模型安排定时控制量
+         *
+         * @param commands 控制量，不要求有序
+         */
+        DLL_EXPORT result<void>
+        schedule_physical(const std::vector<timed_physical> &commands);
+        
+        /**
+         * 清空尚未发出的定时控制量
+         */
+        DLL_EXPORT result<void>
+        clear_schedule();
+        
+        /**
+         * 设置控制频率
+         *
+         * @param rate 控制频率（Hz），为 0 时控制节拍跟随舵轮应答
+         */
+        DLL_EXPORT result<void>
+        set_control_rate(double rate);
+        
+        /**
+         * 开始跟随路径，到达或越过终点后停车，暂停期间停车
+         *
+         * @param points    路点，至多 1024 个
+         * @param speed     线速度
+         * @param lookahead 前视距离
+         */
+        DLL_EXPORT result<void>
+        follow_path(const std::vector<waypoint> &points,
+                    double speed,
+                    double lookahead);
+        
+        /**
+         * 在跟随的路径末尾追加路点
+         */
+        DLL_EXPORT result<void>
+        append_path(const std::vector<waypoint> &points);
+        
+        /**
+         * 停止跟随路径并停车
+         */
+        DLL_EXPORT result<void>
+        clear_path();
+        
+        /**
+         * 获取路径跟随状态
+         */
+        DLL_EXPORT result<path_stats>
+        get_path_stats();
+        
         /**
          * 直线行驶
          *
@@ -370,6 +676,17 @@ namespace autolabor {
                       double a,
                       double *progress = nullptr);
         
+        /**
+         * 控制机器人连续运行多个运动段
+         * 段间不必要的停车被省去，只在最后一段的终点停车
+         *
+         * @param segments 运动段
+         * @param progress 进度
+         */
+        DLL_EXPORT result<void>
+        drive_segments(const std::vector<segment> &segments,
+                       double *progress = nullptr);
+        
         /**
          * 控制机器人按时间约束运行指定动作
          *
@@ -21,6 +21,7 @@ namespace autolabor {
             max_w,           // 最大底盘角速度
             optimize_width,  // 优化函数半宽度
             acceleration,    // 最大动力轮角加速度
+            jerk,            // 动作的最大加加速度，为 0 时动作按梯形速度曲线加减速
         };
         
         /**
@@ -32,6 +33,57 @@ namespace autolabor {
             error    = 0x7f, // 已连接但异常
             locked   = 0xff  // 已锁定
         };
+        
+        /**
+         * 遥测订阅的项目，可按位组合
+         */
+        enum class topic : unsigned int {
+            odometry = 1u << 0, // 里程计更新，约 20 Hz
+            rudder   = 1u << 1, // 后轮方向角更新，约 50 Hz
+            state    = 1u << 2, // 节点状态变化
+            battery  = 1u << 3, // 电池电量变化
+        };
+        
+        /**
+         * 可周期查询的对话，应答的数据域按原样提供
+         */
+        enum class dialog_id : unsigned int {
+            battery_time,          // 电池剩余时间
+            battery_quantity,      // 电池电量
+            battery_voltage,       // 电池电压
+            battery_current,       // 电池电流
+            control_pad,           // 手柄
+            power_switch,          // 急停开关
+            ecu0_speed,            // 左轮当前速度
+            ecu1_speed,            // 右轮当前速度
+            tcu_speed,             // 后轮转向速度
+            ecu0_uptime,           // 左轮控制器累计运行时间
+            ecu1_uptime,           // 右轮控制器累计运行时间
+            tcu_uptime,            // 转向控制器累计运行时间
+            vcu_uptime,            // 整车控制器累计运行时间
+            ecu0_software_version, // 左轮控制器软件版本
+            ecu1_software_version, // 右轮控制器软件版本
+            tcu_software_version,  // 转向控制器软件版本
+            vcu_software_version,  // 整车控制器软件版本
+        };
+        
+        /**
+         * 错误码
+         */
+        enum class error_code : unsigned int {
+            none,                // 无错误
+            other,               // 其他错误，详见错误信息
+            no_available_port,   // 没有可用的串口
+            connection_failed,   // 串口连接失败
+            null_chassis,        // 底盘未连接
+            action_conflict,     // 另一个动作正在执行
+            action_canceled,     // 动作被取消
+            chassis_locked,      // 底盘已锁定
+            critical_state,      // 节点状态异常
+            undefined_parameter, // 未定义的参数
+            no_subscriber_slot,  // 订阅者已满
+            timeout,             // 等待超时
+        };
     } // namespace pm1
 } // namespace autolabor
 
@@ -10,57 +10,294 @@
 #include <sstream>
 #include <unordered_set>
 #include <cmath>
+#include <thread>
+#include <fstream>
+#include <cstdlib>
+#include <condition_variable>
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
 
 #include "pm1_sdk_definitions.h"
 
 #include <utilities/raii/safe_shared_ptr.hpp>
 #include <utilities/raii/weak_lock_guard.hpp>
-#include <utilities/raii/weak_shared_lock.hpp>
 #include <utilities/raii/exception_engine.hpp>
 
 #include <utilities/serial_port/serial.h>
+#include <utilities/shared_memory/shm_ring.hpp>
+#include <utilities/time/time_extensions.h>
 
 #include "internal/chassis.hh"
 #include "internal/process_controller.hpp"
+#include "internal/segment_plan_t.hh"
+#include "internal/jerk_profile_t.hh"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "performance-unnecessary-value-param"
 
-constexpr auto action_conflict = "another action is invoking";
+constexpr auto
+    action_conflict      = "another action is invoking",
+    action_canceled      = "action canceled",
+    chassis_locked       = "chassis is locked",
+    undefined_id         = "undefined id",
+    undefined_subscriber = "undefined subscription",
+    wait_timeout         = "timeout",
+    no_subscriber_slot   = "too many subscribers",
+    no_available_port    = "no available port",
+    inside_callback      = "cannot connect or disconnect inside a telemetry callback",
+    null_chassis_pointer = "null chassis pointer";
 
 // region task resources
 
-using handler_t = autolabor::pm1::native::handler_t;
+using handler_t  = autolabor::pm1::native::handler_t;
+using error_code = autolabor::pm1::error_code;
 
 std::atomic<handler_t> task_id(0);
 
-autolabor::exception_engine<handler_t> exceptions; // NOLINT(cert-err58-cpp)
+// 错误信息被之后的操作覆盖时报告错误，不会误报为成功
+autolabor::exception_engine<handler_t, error_code> exceptions(error_code::other, "error information evicted"); // NOLINT(cert-err58-cpp)
+
+/** 携带错误码的异常 */
+struct coded_error : public std::logic_error {
+    error_code code;
+    
+    coded_error(error_code code, const std::string &what)
+        : std::logic_error(what), code(code) {}
+};
+
+/** 将异常记录到错误管理器 */
+inline void set_exception(handler_t id, const std::exception &e) noexcept {
+    auto coded = dynamic_cast<const coded_error *>(&e);
+    exceptions.set_detail(id, coded ? coded->code : error_code::other, e.what());
+}
 
 // endregion
 // region chassis resources
 
 safe_shared_ptr<autolabor::pm1::chassis> chassis_ptr;
-using ptr_t = decltype(chassis_ptr)::ptr_t;
+using owner_t = decltype(chassis_ptr)::ptr_t;
+using ptr_t   = decltype(chassis_ptr)::raw_t;
 
 std::atomic<autolabor::odometry_t<>>
     odometry_mark{};
 
+// endregion
+// region subscription
+
+/** 订阅者槽位 */
+struct subscriber_t {
+    enum state_t : unsigned { free, busy, active };
+    
+    std::atomic<unsigned> state{free},
+                          calling{0}, // 正在执行的回调数
+                          count{0};   // 抽取计数
+    
+    autolabor::pm1::native::telemetry_callback_t callback = nullptr;
+    
+    void         *user      = nullptr;
+    unsigned int topics     = 0,
+                 decimation = 1;
+};
+
+std::array<subscriber_t, 16> subscribers;
+
+/** 当前线程是否正在执行订阅回调 */
+thread_local bool in_callback = false;
+
+/** 将底盘快照转换为接口结构 */
+void fill_telemetry(const autolabor::pm1::telemetry_snapshot_t &snapshot,
+                    autolabor::pm1::native::telemetry_t &telemetry) {
+    const auto odometry = snapshot.odometry - odometry_mark;
+    telemetry.seq             = snapshot.seq;
+    telemetry.stamp           = autolabor::duration_seconds<>(snapshot.time.time_since_epoch());
+    telemetry.s               = odometry.s;
+    telemetry.a               = odometry.a;
+    telemetry.x               = odometry.x;
+    telemetry.y               = odometry.y;
+    telemetry.theta           = odometry.theta;
+    telemetry.left_position   = snapshot.left.position;
+    telemetry.left_speed      = snapshot.left.speed;
+    telemetry.right_position  = snapshot.right.position;
+    telemetry.right_speed     = snapshot.right.speed;
+    telemetry.rudder_position = snapshot.rudder.position;
+    telemetry.rudder_speed    = snapshot.rudder.speed;
+    telemetry.battery_percent = snapshot.battery_percent;
+    for (size_t i = 0; i < snapshot.state.states.size(); ++i)
+        telemetry.states[i] = static_cast<unsigned char>(snapshot.state.states[i]);
+}
+
+/** 最新快照，供阻塞等待的线程读取 */
+struct latest_t {
+    std::mutex              mutex;
+    std::condition_variable signal;
+    std::atomic<size_t>     waiters{0};
+    bool                    online = false;
+    
+    autolabor::pm1::telemetry_snapshot_t snapshot{};
+    std::array<unsigned long long, 4>    topic_seq{}; // 各项目最后一次更新时的快照序号
+    
+    const void *source = nullptr; // 发布快照的底盘，只用于比较
+    bool       posed   = true;    // 快照中的位姿是否已补全
+} latest;
+
+/** 设置连接状态，唤醒等待的线程 */
+void set_online(bool online) {
+    {
+        std::lock_guard<decltype(latest.mutex)> lock(latest.mutex);
+        latest.online = online;
+    }
+    latest.signal.notify_all();
+}
+
+#if defined(__linux__)
+/** 共享内存遥测发布 */
+using ring_t = autolabor::shm_ring_writer<autolabor::pm1::native::telemetry_t>;
+safe_shared_ptr<ring_t> ring_ptr;
+std::atomic<bool>       ring_enabled{false};
+#endif
+
+/**
+ * 补全等待者取得的快照中未推算的位姿
+ *
+ * 只在发布快照的底盘仍是当前底盘时补全，底盘已被替换时保持原样，等待新底盘的快照
+ */
+autolabor::pm1::telemetry_snapshot_t with_pose(const void *source, autolabor::pm1::telemetry_snapshot_t snapshot) {
+    try {
+        chassis_ptr.read([&](ptr_t ptr) {
+            if (ptr == source) snapshot.odometry = ptr->odometry().value;
+        });
+    } catch (std::exception &) {}
+    return snapshot;
+}
+
+/** 在读线程中分发遥测更新 */
+void dispatch(const autolabor::pm1::chassis &source,
+              const autolabor::pm1::telemetry_snapshot_t &published,
+              unsigned int changed) {
+    // 延迟推算位姿时快照不含最新位姿，有读者时才从发布快照的底盘推算
+    auto       snapshot = published;
+    auto       posed    = !source.is_odometry_lazy();
+    const auto pose     = [&] {
+        if (posed) return;
+        snapshot.odometry = source.odometry().value;
+        posed = true;
+    };
+    
+    autolabor::pm1::native::telemetry_t telemetry{};
+    auto                                filled = false;
+    const auto                          fill   = [&] {
+        if (filled) return;
+        pose();
+        fill_telemetry(snapshot, telemetry);
+        filled = true;
+    };
+    
+    if (latest.waiters) pose();
+    {
+        std::lock_guard<decltype(latest.mutex)> lock(latest.mutex);
+        latest.snapshot = snapshot;
+        latest.source   = &source;
+        latest.posed    = posed;
+        for (size_t i = 0; i < latest.topic_seq.size(); ++i)
+            if (changed & (1u << i)) latest.topic_seq[i] = snapshot.seq;
+    }
+    if (latest.waiters) latest.signal.notify_all();
+    
+    #if defined(__linux__)
+    if (ring_enabled) {
+        fill();
+        try { ring_ptr.read([&](ring_t *ring) { ring->write(telemetry); }); }
+        catch (std::exception &) {}
+    }
+    #endif
+    
+    in_callback = true;
+    for (auto &slot : subscribers) {
+        if (slot.state != subscriber_t::active) continue;
+        // 先登记再复查状态，之后槽位的字段不会被订阅或取消订阅改写
+        ++slot.calling;
+        if (slot.state == subscriber_t::active) {
+            const auto topics = slot.topics & changed;
+            if (topics && ++slot.count >= slot.decimation) {
+                slot.count = 0;
+                fill();
+                slot.callback(&telemetry, topics, slot.user);
+            }
+        }
+        --slot.calling;
+    }
+    in_callback = false;
+}
+
 // endregion
 // region action resource
 
-std::mutex    action_mutex;
-volatile bool pause_flag       = false,
-              cancel_flag      = false;
+std::mutex              action_mutex;
+std::atomic<bool>       pause_flag{false},
+                        cancel_flag{false},
+                        acting{false};
+std::mutex              signal_mutex;
+std::condition_variable action_signal;
+
+/** 动作的检查周期 */
+constexpr auto action_period = std::chrono::milliseconds(50);
+
+/**
+ * 等待一个检查周期
+ *
+ * 取消，或暂停标记不再等于 paused 时立即返回
+ */
+inline void wait_action_signal(bool paused,
+                               std::chrono::milliseconds period = action_period) {
+    std::unique_lock<decltype(signal_mutex)> lock(signal_mutex);
+    action_signal.wait_for(lock, period, [paused] { return cancel_flag || pause_flag != paused; });
+}
+
+/** 在作用域内标记动作正在执行 */
+struct acting_guard {
+    acting_guard() { acting = true; }
+    
+    ~acting_guard() { acting = false; }
+};
+
+/**
+ * 修改标记并唤醒等待中的动作
+ *
+ * @param stop 若有动作正在执行，先在调用线程上停车再唤醒
+ */
+inline void raise_action_signal(std::atomic<bool> &flag, bool value, bool stop) {
+    const bool running = acting;
+    {
+        std::lock_guard<decltype(signal_mutex)> lock(signal_mutex);
+        flag = value;
+    }
+    if (stop && running)
+        try {
+            chassis_ptr.read([](ptr_t ptr) { ptr->stop(); });
+        } catch (...) {}
+    action_signal.notify_all();
+}
+
+/** 动作设置目标；与标记的修改互斥，取消或暂停之后只能设置零速度 */
+inline void set_action_target(ptr_t ptr, double speed, double rudder) {
+    std::lock_guard<decltype(signal_mutex)> lock(signal_mutex);
+    ptr->set_target(cancel_flag || pause_flag ? 0 : speed, rudder);
+}
 
 // endregion
 
-inline handler_t use_ptr(std::function < void(ptr_t) > && block) {
+template<class f_t>
+inline handler_t use_ptr(f_t &&block) {
     handler_t id = ++task_id;
     try {
-        chassis_ptr.read<void>(block);
+        chassis_ptr.read(std::forward<f_t>(block));
     }
     catch (std::exception &e) {
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     return id;
 }
@@ -72,6 +309,13 @@ get_error_info(handler_t handler) noexcept {
     return exceptions[handler];
 }
 
+unsigned int
+STD_CALL
+autolabor::pm1::native::
+get_error_code(handler_t handler) noexcept {
+    return static_cast<unsigned int>(exceptions.code(handler));
+}
+
 void
 STD_CALL
 autolabor::pm1::native::
@@ -95,6 +339,43 @@ get_connected_port() noexcept {
     return connected_port.c_str();
 }
 
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_auto_reconnect(bool value) noexcept {
+    return use_ptr([value](ptr_t ptr) {
+        ptr->auto_reconnect = value;
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_connection_info_c(connection_info_t *info) noexcept {
+    return get_connection_info(*info);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_connection_info(connection_info_t &info) noexcept {
+    return use_ptr([&info](ptr_t ptr) {
+        auto stats = ptr->link_stats();
+        info = {stats.reconnect_count,
+                stats.last_outage,
+                stats.max_outage,
+                stats.total_outage,
+                stats.latency_timer,
+                stats.original_latency_timer,
+                stats.planned_utilisation,
+                stats.utilisation,
+                stats.odometry_period,
+                stats.state_period,
+                stats.control_rate,
+                stats.stale_rudder_cycles};
+    });
+}
+
 double
 STD_CALL
 autolabor::pm1::native::
@@ -127,6 +408,9 @@ get_default_parameter(handler_t id) noexcept {
         case parameter_id::acceleration:
             return chassis::default_acceleration;
         
+        case parameter_id::jerk:
+            return chassis::default_jerk;
+        
         default:
             return NAN;
     }
@@ -172,8 +456,11 @@ get_parameter(handler_t id, double &value) noexcept {
             case parameter_id::acceleration:
                 value = ptr->acceleration;
                 break;
+            case parameter_id::jerk:
+                value = ptr->jerk;
+                break;
             default:
-                throw std::logic_error("undefined id");
+                throw coded_error(error_code::undefined_parameter, undefined_id);
         }
     });
 }
@@ -211,8 +498,11 @@ set_parameter(handler_t id, double value) noexcept {
             case parameter_id::acceleration:
                 ptr->acceleration = temp;
                 break;
+            case parameter_id::jerk:
+                ptr->jerk = std::max(0.0f, temp);
+                break;
             default:
-                throw std::logic_error("undefined id");
+                throw coded_error(error_code::undefined_parameter, undefined_id);
         }
     });
 }
@@ -231,56 +521,250 @@ get_battery_percent(double &battery_percent) noexcept {
     return use_ptr([&](ptr_t ptr) { battery_percent = ptr->battery_percent(); });
 }
 
+// region port probe
+
+#if defined(_MSC_VER)
+
+/** 串口缓存文件路径，TEMP 目录属于当前用户 */
+std::string port_cache_path() {
+    const auto directory = std::getenv("TEMP");
+    return std::string(directory ? directory : ".") + "\\pm1_sdk_port";
+}
+
+/** 读取上次连接成功的串口 */
+serial::PortInfo load_port_cache() {
+    serial::PortInfo result;
+    std::ifstream    file(port_cache_path());
+    std::getline(file, result.hardware_id);
+    std::getline(file, result.port);
+    return result;
+}
+
+/** 记录连接成功的串口 */
+void save_port_cache(const serial::PortInfo &info) {
+    std::ofstream file(port_cache_path(), std::ios::trunc);
+    file << info.hardware_id << std::endl
+         << info.port << std::endl;
+}
+
+#else
+
+/** 串口缓存文件路径，位于当前用户的缓存目录，不可用时为空 */
+std::string port_cache_path() {
+    const auto xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) return std::string(xdg) + "/pm1_sdk_port";
+    
+    const auto home = std::getenv("HOME");
+    if (!home || !*home) return {};
+    const auto directory = std::string(home) + "/.cache";
+    mkdir(directory.c_str(), 0700); // 已存在时失败，不影响
+    return directory + "/pm1_sdk_port";
+}
+
+/** 读取上次连接成功的串口，不跟随符号链接 */
+serial::PortInfo load_port_cache() {
+    serial::PortInfo result;
+    
+    const auto path = port_cache_path();
+    if (path.empty()) return result;
+    const auto handle = open(path.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (handle < 0) return result;
+    char       buffer[1024];
+    const auto size = read(handle, buffer, sizeof(buffer));
+    close(handle);
+    if (size <= 0) return result;
+    
+    std::istringstream file(std::string(buffer, static_cast<size_t>(size)));
+    std::getline(file, result.hardware_id);
+    std::getline(file, result.port);
+    return result;
+}
+
+/** 记录连接成功的串口；写入独占创建的临时文件再改名，不会写穿符号链接 */
+void save_port_cache(const serial::PortInfo &info) {
+    const auto path = port_cache_path();
+    if (path.empty()) return;
+    const auto temp   = path + "." + std::to_string(getpid());
+    const auto handle = open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+    if (handle < 0) return;
+    
+    const auto text = info.hardware_id + '\n' + info.port + '\n';
+    const auto done = write(handle, text.data(), text.size()) == static_cast<ssize_t>(text.size());
+    close(handle);
+    if (!done || rename(temp.c_str(), path.c_str()) != 0)
+        unlink(temp.c_str());
+}
+
+#endif
+
+/** 判断串口是否与缓存记录是同一设备 */
+bool match_port_cache(const serial::PortInfo &cache, const serial::PortInfo &info) {
+    // 硬件标识不可用时，退化为比较串口名字
+    return cache.hardware_id.empty() || cache.hardware_id == "n/a"
+           ? !cache.port.empty() && cache.port == info.port
+           : cache.hardware_id == info.hardware_id;
+}
+
+/** 并行探测的共享状态 */
+struct probe_t {
+    std::mutex               mutex;
+    std::condition_variable  signal;
+    std::atomic<bool>        cancel{false};
+    owner_t                  winner;
+    serial::PortInfo         info;
+    std::vector<std::string> errors;
+    size_t                   finished = 0;
+};
+
+/**
+ * 同时探测一组串口
+ *
+ * 第一个应答为 PM1 的串口胜出；
+ * 随即取消其余探测，等待它们关闭串口、线程结束后返回
+ *
+ * @param list        候选串口
+ * @param baud_rate   波特率
+ * @param low_latency 是否以低延迟模式打开串口
+ * @param state       共享状态
+ * @param single      是否只有一个候选串口
+ * @param progress    进度回调，参数为已结束的探测数
+ */
+void probe_ports(const std::vector<serial::PortInfo> &list,
+                 unsigned int baud_rate,
+                 bool low_latency,
+                 const std::shared_ptr<probe_t> &state,
+                 bool single,
+                 const std::function<void(size_t)> &progress) {
+    if (list.empty()) return;
+    
+    size_t launched;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        launched = state->finished + list.size();
+    }
+    
+    std::vector<std::thread> threads;
+    threads.reserve(list.size());
+    for (const auto &info : list)
+        threads.emplace_back([state, info, single, baud_rate, low_latency] {
+            owner_t     ptr;
+            std::string error;
+            try {
+                #ifdef __GNUC__
+                const static std::string except = "/dev/ttyS";
+                if (single && info.port.substr(0, except.size()) == except) throw std::logic_error("skip ttyS.");
+                #endif
+                ptr = std::make_shared<autolabor::pm1::chassis>(info.port, baud_rate, low_latency, &state->cancel);
+            } catch (std::exception &e) {
+                error = e.what();
+            }
+            // 落选的底盘对象在锁外析构
+            std::lock_guard<std::mutex> lock(state->mutex);
+            ++state->finished;
+            if (!ptr)
+                state->errors.push_back(info.port + " : " + error);
+            else if (!state->winner) {
+                state->winner = std::move(ptr);
+                state->info   = info;
+            }
+            state->signal.notify_all();
+        });
+    
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (!state->winner && state->finished < launched) {
+            state->signal.wait(lock);
+            progress(state->finished);
+        }
+    }
+    state->cancel = true;
+    for (auto &thread : threads) thread.join();
+}
+
+// endregion
+
 handler_t
 STD_CALL
 autolabor::pm1::native::
 initialize_c(const char *port,
              double *progress) noexcept {
-    const static auto serial_ports = [] {
-        auto                     info = serial::list_ports();
-        std::vector<std::string> result(info.size());
-        std::transform(info.begin(), info.end(), result.begin(),
-                       [](const serial::PortInfo &it) { return it.port; });
-        return result;
-    };
-    
+    return initialize_ex_c(port, 115200, false, progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+initialize(const char *port,
+           double &progress) noexcept {
+    return initialize_c(port, &progress);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+initialize_ex_c(const char *port,
+                unsigned int baud_rate,
+                bool low_latency,
+                double *progress) noexcept {
     handler_t id = ++task_id;
     
-    auto list = port == nullptr || std::strlen(port) == 0
-                ? serial_ports()
-                : std::vector<std::string>{std::string(port)};
+    // 回调在底盘读线程上执行，替换底盘会在读线程上析构底盘并等待读线程自己
+    if (in_callback) {
+        exceptions.set(id, error_code::other, inside_callback);
+        return id;
+    }
+    
+    const auto automatic = port == nullptr || std::strlen(port) == 0;
+    
+    auto list = automatic
+                ? serial::list_ports()
+                : std::vector<serial::PortInfo>{{std::string(port), "", ""}};
     
+    *progress = 0;
     if (list.empty())
-        exceptions.set(id, "no available port");
+        exceptions.set(id, error_code::no_available_port, no_available_port);
     else {
-        std::stringstream builder;
+        // 上次连接成功的设备优先探测，失败后再同时探测其他串口
+        std::vector<serial::PortInfo> preferred, others;
+        if (automatic) {
+            const auto cache = load_port_cache();
+            for (auto &info : list)
+                (match_port_cache(cache, info) ? preferred : others).push_back(std::move(info));
+        } else
+            others = std::move(list);
+        
+        const auto total  = preferred.size() + others.size();
+        const auto state  = std::make_shared<probe_t>();
+        const auto update = [=](size_t finished) { *progress = static_cast<double>(finished) / total; };
+        
+        probe_ports(preferred, baud_rate, low_latency, state, total == 1, update);
+        if (!state->winner)
+            probe_ports(others, baud_rate, low_latency, state, total == 1, update);
         
-        for (auto i = list.begin();;) {
-            *progress = static_cast<double>(i - list.begin()) / list.size();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->winner) {
+            state->winner->observer = dispatch;
             try {
-                #ifdef __GNUC__
-                const static std::string except = "/dev/ttyS";
-                if (list.size() == 1 && i->substr(0, except.size()) == except) throw std::logic_error("skip ttyS.");
-                #endif
-                auto ptr = std::make_shared<chassis>(*i);
-                
-                chassis_ptr(ptr);
-                builder.str("");
-                odometry_mark  = ptr->odometry().value;
-                connected_port = *i;
-                pause_flag     = false;
-                cancel_flag    = false;
-                break;
+                chassis_ptr(state->winner);
+            } catch (std::exception &e) {
+                set_exception(id, e);
+                *progress = 1;
+                return id;
             }
-            catch (std::exception &e) {
-                builder << *i << " : " << e.what();
-                if (++i < list.end())
-                    builder << std::endl;
-                else
-                    break;
+            set_online(true);
+            odometry_mark  = state->winner->odometry().value;
+            connected_port = state->info.port;
+            pause_flag     = false;
+            cancel_flag    = false;
+            if (automatic) save_port_cache(state->info);
+        } else {
+            std::stringstream builder;
+            for (auto i = state->errors.begin(); i < state->errors.end(); ++i) {
+                if (i != state->errors.begin()) builder << std::endl;
+                builder << *i;
             }
+            exceptions.set_detail(id, error_code::connection_failed, builder.str().c_str());
         }
-        exceptions.set(id, builder.str());
     }
     
     *progress = 1;
@@ -290,9 +774,11 @@ initialize_c(const char *port,
 handler_t
 STD_CALL
 autolabor::pm1::native::
-initialize(const char *port,
-           double &progress) noexcept {
-    return initialize_c(port, &progress);
+initialize_ex(const char *port,
+              unsigned int baud_rate,
+              bool low_latency,
+              double &progress) noexcept {
+    return initialize_ex_c(port, baud_rate, low_latency, &progress);
 }
 
 handler_t
@@ -300,8 +786,19 @@ STD_CALL
 autolabor::pm1::native::
 shutdown() noexcept {
     handler_t id = ++task_id;
-    if (!chassis_ptr(nullptr))
-        exceptions.set(id, "null chassis pointer");
+    if (in_callback) {
+        exceptions.set(id, error_code::other, inside_callback);
+        return id;
+    }
+    set_online(false);
+    try {
+        if (!chassis_ptr(nullptr))
+            exceptions.set(id, error_code::null_chassis, null_chassis_pointer);
+    } catch (std::exception &e) {
+        set_online(true);
+        set_exception(id, e);
+        return id;
+    }
     connected_port.clear();
     return id;
 }
@@ -319,12 +816,12 @@ autolabor::pm1::native::
 get_rudder(double &rudder) noexcept {
     handler_t id = ++task_id;
     try {
-        rudder = chassis_ptr.read<double>([&](ptr_t ptr) {
+        rudder = chassis_ptr.read([&](ptr_t ptr) {
             return ptr->rudder().position;
         });
     } catch (std::exception &e) {
         rudder = NAN;
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     return id;
 }
@@ -347,7 +844,7 @@ get_odometry(double &stamp,
              double &x, double &y, double &theta) noexcept {
     handler_t id = ++task_id;
     try {
-        chassis_ptr.read<void>([&](ptr_t ptr) {
+        chassis_ptr.read([&](ptr_t ptr) {
             auto value = ptr->odometry();
             auto temp  = value.value - odometry_mark;
             stamp = duration_seconds<>(value.time.time_since_epoch());
@@ -365,11 +862,314 @@ get_odometry(double &stamp,
         x     = NAN;
         y     = NAN;
         theta = NAN;
-        exceptions.set(id, e.what());
+        set_exception(id, e);
+    }
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_telemetry_c(telemetry_t *telemetry) noexcept {
+    return get_telemetry(*telemetry);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_telemetry(telemetry_t &telemetry) noexcept {
+    handler_t id = ++task_id;
+    try {
+        fill_telemetry(chassis_ptr.read([](ptr_t ptr) { return ptr->telemetry(); }), telemetry);
+    } catch (std::exception &e) {
+        telemetry = {};
+        telemetry.stamp = NAN;
+        set_exception(id, e);
     }
     return id;
 }
 
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_rtt_stats_c(unsigned int node, rtt_stats_t *stats) noexcept {
+    return get_rtt_stats(node, *stats);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_rtt_stats(unsigned int node, rtt_stats_t &stats) noexcept {
+    stats = {};
+    return use_ptr([node, &stats](ptr_t ptr) {
+        if (node >= 4)
+            throw coded_error(error_code::undefined_parameter, undefined_id);
+        const auto rtt = ptr->rtt_stats(node);
+        stats = {rtt.samples,
+                 rtt.lost,
+                 rtt.min,
+                 rtt.avg,
+                 rtt.p99,
+                 duration_seconds(ptr->node_timeout(node)),
+                 rtt.p99 > 0 ? 1 / rtt.p99 : 0};
+    });
+}
+
+/** 类型标签，把查询帧类型传给泛型 lambda */
+template<class t>
+struct tag_t { using type = t; };
+
+/** 按对话编号选出查询帧类型 */
+template<class f_t>
+inline void with_dialog(unsigned int id, f_t &&f) {
+    using namespace autolabor::pm1;
+    switch (static_cast<dialog_id>(id)) {
+        case dialog_id::battery_time:
+            f(tag_t<vcu<0>::battery_time_tx>{});
+            break;
+        case dialog_id::battery_quantity:
+            f(tag_t<vcu<0>::battery_quantity_tx>{});
+            break;
+        case dialog_id::battery_voltage:
+            f(tag_t<vcu<0>::battery_voltage_tx>{});
+            break;
+        case dialog_id::battery_current:
+            f(tag_t<vcu<0>::battery_current_tx>{});
+            break;
+        case dialog_id::control_pad:
+            f(tag_t<vcu<0>::control_pad_tx>{});
+            break;
+        case dialog_id::power_switch:
+            f(tag_t<vcu<0>::power_switch_tx>{});
+            break;
+        case dialog_id::ecu0_speed:
+            f(tag_t<ecu<0>::current_speed_tx>{});
+            break;
+        case dialog_id::ecu1_speed:
+            f(tag_t<ecu<1>::current_speed_tx>{});
+            break;
+        case dialog_id::tcu_speed:
+            f(tag_t<tcu<0>::current_speed_tx>{});
+            break;
+        case dialog_id::ecu0_uptime:
+            f(tag_t<unit<ecu<0>>::uptime_tx>{});
+            break;
+        case dialog_id::ecu1_uptime:
+            f(tag_t<unit<ecu<1>>::uptime_tx>{});
+            break;
+        case dialog_id::tcu_uptime:
+            f(tag_t<unit<tcu<0>>::uptime_tx>{});
+            break;
+        case dialog_id::vcu_uptime:
+            f(tag_t<unit<vcu<0>>::uptime_tx>{});
+            break;
+        case dialog_id::ecu0_software_version:
+            f(tag_t<unit<ecu<0>>::software_version_tx>{});
+            break;
+        case dialog_id::ecu1_software_version:
+            f(tag_t<unit<ecu<1>>::software_version_tx>{});
+            break;
+        case dialog_id::tcu_software_version:
+            f(tag_t<unit<tcu<0>>::software_version_tx>{});
+            break;
+        case dialog_id::vcu_software_version:
+            f(tag_t<unit<vcu<0>>::software_version_tx>{});
+            break;
+        default:
+            throw coded_error(error_code::undefined_parameter, undefined_id);
+    }
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_poll_period(unsigned int dialog, double period) noexcept {
+    return use_ptr([dialog, period](ptr_t ptr) {
+        const auto value = period > 0
+                           ? std::chrono::milliseconds(std::max(1L, std::lround(period * 1000)))
+                           : std::chrono::milliseconds::zero();
+        with_dialog(dialog, [ptr, value](auto tag) {
+            ptr->poll<typename decltype(tag)::type>(value);
+        });
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_polled_c(unsigned int dialog, polled_t *value) noexcept {
+    return get_polled(dialog, *value);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_polled(unsigned int dialog, polled_t &value) noexcept {
+    value = {};
+    return use_ptr([dialog, &value](ptr_t ptr) {
+        with_dialog(dialog, [ptr, &value](auto tag) {
+            const auto latest = ptr->polled<typename decltype(tag)::type>();
+            if (latest.time.time_since_epoch().count() == 0) return;
+            value.stamp = duration_seconds<>(latest.time.time_since_epoch());
+            std::copy(latest.value.begin(), latest.value.end(), value.data);
+        });
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+wait_telemetry_c(unsigned int topics,
+                 unsigned long long after_seq,
+                 double timeout,
+                 telemetry_t *telemetry) noexcept {
+    return wait_telemetry(topics, after_seq, timeout, *telemetry);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+wait_telemetry(unsigned int topics,
+               unsigned long long after_seq,
+               double timeout,
+               telemetry_t &telemetry) noexcept {
+    handler_t id = ++task_id;
+    
+    const auto updated = [topics, after_seq] {
+        for (size_t i = 0; i < latest.topic_seq.size(); ++i)
+            if ((topics & (1u << i)) && latest.topic_seq[i] > after_seq)
+                return true;
+        return false;
+    };
+    
+    // 限幅后再转换，过大或无穷的超时换算成时钟刻度时会溢出；NaN 视为 0
+    constexpr static auto max_timeout = 1e8; // 约 3 年
+    const auto            limited     = timeout > 0 ? std::min(timeout, max_timeout) : .0;
+    
+    std::unique_lock<decltype(latest.mutex)> lock(latest.mutex);
+    ++latest.waiters;
+    const auto ready = latest.signal.wait_for(
+        lock,
+        std::chrono::duration<double>(limited),
+        [&] { return !latest.online || updated(); });
+    --latest.waiters;
+    
+    if (!latest.online)
+        exceptions.set(id, error_code::null_chassis, null_chassis_pointer);
+    else if (!ready)
+        exceptions.set(id, error_code::timeout, wait_timeout);
+    else {
+        const auto snapshot = latest.snapshot;
+        const auto source   = latest.source;
+        const auto posed    = latest.posed;
+        lock.unlock();
+        fill_telemetry(posed ? snapshot : with_pose(source, snapshot), telemetry);
+        return id;
+    }
+    telemetry = {};
+    telemetry.stamp = NAN;
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+start_telemetry_ring(const char *name, unsigned int capacity) noexcept {
+    handler_t id = ++task_id;
+    #if defined(__linux__)
+    try {
+        // 先移除旧的发布，避免同名时旧对象析构移除新的共享内存
+        ring_enabled = false;
+        ring_ptr(nullptr);
+        ring_ptr(std::make_shared<ring_t>(name, capacity));
+        ring_enabled = true;
+    } catch (std::exception &e) {
+        set_exception(id, e);
+    }
+    #else
+    exceptions.set(id, error_code::other, "shared memory telemetry is not supported on this platform");
+    #endif
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+stop_telemetry_ring() noexcept {
+    handler_t id = ++task_id;
+    #if defined(__linux__)
+    ring_enabled = false;
+    ring_ptr(nullptr);
+    #endif
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+subscribe_c(unsigned int topics,
+            unsigned int decimation,
+            telemetry_callback_t callback,
+            void *user,
+            unsigned int *subscription) noexcept {
+    return subscribe(topics, decimation, callback, user, *subscription);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+subscribe(unsigned int topics,
+          unsigned int decimation,
+          telemetry_callback_t callback,
+          void *user,
+          unsigned int &subscription) noexcept {
+    handler_t id = ++task_id;
+    subscription = 0;
+    if (!callback) {
+        exceptions.set(id, error_code::other, "null callback");
+        return id;
+    }
+    for (size_t i = 0; i < subscribers.size(); ++i) {
+        auto &slot    = subscribers[i];
+        auto expected = static_cast<unsigned>(subscriber_t::free);
+        if (!slot.state.compare_exchange_strong(expected, subscriber_t::busy))
+            continue;
+        slot.callback   = callback;
+        slot.user       = user;
+        slot.topics     = topics;
+        slot.decimation = std::max(1u, decimation);
+        slot.count      = 0;
+        slot.state      = subscriber_t::active;
+        subscription = static_cast<unsigned int>(i + 1);
+        return id;
+    }
+    exceptions.set(id, error_code::no_subscriber_slot, no_subscriber_slot);
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+unsubscribe(unsigned int subscription) noexcept {
+    handler_t id = ++task_id;
+    if (subscription == 0 || subscription > subscribers.size()) {
+        exceptions.set(id, error_code::other, undefined_subscriber);
+        return id;
+    }
+    auto &slot    = subscribers[subscription - 1];
+    auto expected = static_cast<unsigned>(subscriber_t::active);
+    if (!slot.state.compare_exchange_strong(expected, subscriber_t::busy)) {
+        exceptions.set(id, error_code::other, undefined_subscriber);
+        return id;
+    }
+    // 等待正在执行的回调返回；在回调中取消时不能等待自己
+    if (!in_callback)
+        while (slot.calling.load())
+            std::this_thread::yield();
+    slot.state = subscriber_t::free;
+    return id;
+}
+
 handler_t
 STD_CALL
 autolabor::pm1::native::
@@ -388,6 +1188,44 @@ set_command_enabled(bool value) noexcept {
     });
 }
 
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_control_rate(double rate) noexcept {
+    return use_ptr([rate](ptr_t ptr) {
+        if (!(rate == 0 || (1 <= rate && rate <= 1000)))
+            throw coded_error(error_code::undefined_parameter, "control rate must be 0 or in [1, 1000] Hz");
+        ptr->set_control_rate(rate);
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_rudder_prediction(bool value) noexcept {
+    return use_ptr([value](ptr_t ptr) {
+        ptr->predict_rudder = value;
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_lazy_odometry(bool value) noexcept {
+    return use_ptr([value](ptr_t ptr) {
+        ptr->set_lazy_odometry(value);
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+set_wheel_interpolation(bool value) noexcept {
+    return use_ptr([value](ptr_t ptr) {
+        ptr->set_wheel_interpolation(value);
+    });
+}
+
 handler_t
 STD_CALL
 autolabor::pm1::native::
@@ -402,7 +1240,7 @@ STD_CALL
 autolabor::pm1::native::
 check_state() noexcept {
     try {
-        return chassis_ptr.read<unsigned char>([](ptr_t ptr) {
+        return chassis_ptr.read([](ptr_t ptr) {
             auto states = ptr->state().states;
             auto unique = std::unordered_set<node_state_t>(states.begin(), states.end());
             return 1 == unique.size()
@@ -419,17 +1257,14 @@ STD_CALL
 autolabor::pm1::native::
 drive_physical(double speed, double rudder) noexcept {
     handler_t id = ++task_id;
-    
-    weak_lock_guard<decltype(action_mutex)> lock(action_mutex);
-    if (!lock) {
-        exceptions.set(id, action_conflict);
+    if (acting) {
+        exceptions.set(id, error_code::action_conflict, action_conflict);
         return id;
     }
-    
     try {
-        chassis_ptr.read<void>([=](ptr_t ptr) { ptr->set_target(speed, rudder); });
+        chassis_ptr.read([=](ptr_t ptr) { ptr->set_target(speed, rudder); });
     } catch (std::exception &e) {
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     return id;
 }
@@ -439,22 +1274,19 @@ STD_CALL
 autolabor::pm1::native::
 drive_wheels(double left, double right) noexcept {
     handler_t id = ++task_id;
-    
-    weak_lock_guard<decltype(action_mutex)> lock(action_mutex);
-    if (!lock) {
-        exceptions.set(id, action_conflict);
+    if (acting) {
+        exceptions.set(id, error_code::action_conflict, action_conflict);
         return id;
     }
-    
     try {
-        chassis_ptr.read<void>([=](ptr_t ptr) {
+        chassis_ptr.read([=](ptr_t ptr) {
             auto physical = wheels_to_physical(wheels{static_cast<float>(left),
                                                       static_cast<float>(right)},
                                                &ptr->config);
             ptr->set_target(physical.speed, physical.rudder);
         });
     } catch (std::exception &e) {
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     return id;
 }
@@ -464,29 +1296,204 @@ STD_CALL
 autolabor::pm1::native::
 drive_velocity(double v, double w) noexcept {
     handler_t id = ++task_id;
-    
-    weak_lock_guard<decltype(action_mutex)> lock(action_mutex);
-    if (!lock) {
-        exceptions.set(id, action_conflict);
+    if (acting) {
+        exceptions.set(id, error_code::action_conflict, action_conflict);
         return id;
     }
-    
     try {
-        chassis_ptr.read<void>([=](ptr_t ptr) {
+        chassis_ptr.read([=](ptr_t ptr) {
             auto physical = velocity_to_physical(velocity{static_cast<float>(v),
                                                           static_cast<float>(w)},
                                                  &ptr->config);
             ptr->set_target(physical.speed, physical.rudder);
         });
     } catch (std::exception &e) {
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     return id;
 }
 
+/** 把定时控制量换算到物理模型并替换队尾 */
+template<class f_t>
+inline handler_t schedule_commands(const autolabor::pm1::native::timed_command_t *commands,
+                                   unsigned int count,
+                                   f_t &&to_physical) {
+    return use_ptr([=](ptr_t ptr) {
+        if (count && !commands)
+            throw coded_error(error_code::undefined_parameter, "null command pointer");
+        
+        using entry_t = autolabor::pm1::command_schedule_t::entry_t;
+        using time_t  = autolabor::pm1::command_schedule_t::time_t;
+        
+        std::vector<entry_t> entries(count);
+        for (unsigned int i = 0; i < count; ++i) {
+            const auto stamp = std::chrono::duration_cast<time_t::duration>(
+                autolabor::seconds_duration(commands[i].stamp));
+            entries[i] = {time_t(stamp), to_physical(commands[i], ptr->config)};
+        }
+        ptr->schedule.replace_tail(std::move(entries));
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+schedule_velocity(const timed_command_t *commands, unsigned int count) noexcept {
+    return schedule_commands(commands, count, [](const timed_command_t &command, const chassis_config_t &config) {
+        return velocity_to_physical(velocity{static_cast<float>(command.first),
+                                             static_cast<float>(command.second)},
+                                    &config);
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+schedule_physical(const timed_command_t *commands, unsigned int count) noexcept {
+    return schedule_commands(commands, count, [](const timed_command_t &command, const chassis_config_t &) {
+        return physical{static_cast<float>(command.first),
+                        static_cast<float>(command.second)};
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+clear_schedule() noexcept {
+    return use_ptr([](ptr_t ptr) { ptr->schedule.clear(); });
+}
+
+/** 把路点从 get_odometry 坐标系换算到底盘里程计坐标系 */
+inline std::vector<autolabor::pm1::path_follower_t::point_t>
+to_chassis_frame(const autolabor::pm1::native::waypoint_t *points, unsigned int count) {
+    if (count && !points)
+        throw coded_error(error_code::undefined_parameter, "null waypoint pointer");
+    
+    const autolabor::odometry_t<> mark = odometry_mark;
+    
+    std::vector<autolabor::pm1::path_follower_t::point_t> result(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        const auto temp = mark + autolabor::odometry_t<autolabor::odometry_type::delta>{0, 0, points[i].x, points[i].y, 0};
+        result[i] = {temp.x, temp.y};
+    }
+    return result;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+follow_path(const waypoint_t *points,
+            unsigned int count,
+            double speed,
+            double lookahead) noexcept {
+    return use_ptr([=](ptr_t ptr) {
+        if (!(speed > 0 && lookahead > 0))
+            throw coded_error(error_code::undefined_parameter, "speed and lookahead must be positive");
+        if (count > path_follower_t::capacity)
+            throw coded_error(error_code::undefined_parameter, "too many waypoints");
+        
+        const auto temp = to_chassis_frame(points, count);
+        ptr->path.start(temp.data(), temp.size(), speed, lookahead);
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+append_path(const waypoint_t *points, unsigned int count) noexcept {
+    return use_ptr([=](ptr_t ptr) {
+        const auto temp = to_chassis_frame(points, count);
+        if (ptr->path.append(temp.data(), temp.size()) < temp.size())
+            throw coded_error(error_code::undefined_parameter, "waypoint buffer is full");
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+clear_path() noexcept {
+    return use_ptr([](ptr_t ptr) {
+        if (ptr->path.clear()) ptr->stop();
+    });
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_path_stats_c(path_stats_t *stats) noexcept {
+    return get_path_stats(*stats);
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+get_path_stats(path_stats_t &stats) noexcept {
+    stats = {};
+    return use_ptr([&stats](ptr_t ptr) {
+        const auto temp = ptr->path.stats();
+        stats = {temp.count,
+                 temp.last,
+                 temp.rms,
+                 temp.max,
+                 temp.residual,
+                 static_cast<unsigned int>(temp.waypoints),
+                 temp.active};
+    });
+}
+
+/** 动作执行中检查节点状态，异常或被锁定时抛出 */
+inline void check_action_state(ptr_t ptr) {
+    constexpr static auto
+        unknown  = autolabor::pm1::node_state_t::unknown,
+        enabled  = autolabor::pm1::node_state_t::enabled,
+        disabled = autolabor::pm1::node_state_t::disabled;
+    
+    auto states = ptr->state().states;
+    if (std::find(states.begin(), states.end(), unknown) != states.end()) {
+        std::stringstream builder;
+        builder << "critical error: error state -> [ecu0|ecu1|tcu|vcu] = ["
+                << static_cast<int>(states[0]) << '|'
+                << static_cast<int>(states[1]) << '|'
+                << static_cast<int>(states[2]) << '|'
+                << static_cast<int>(states[3]) << ']';
+        throw coded_error(error_code::critical_state, builder.str());
+    }
+    if (std::find(states.begin(), states.end(), disabled) != states.end()
+        && ptr->target_state() != enabled)
+        throw coded_error(error_code::chassis_locked, chassis_locked);
+}
+
+/** 按里程度量约束行驶的过程控制器 */
+const autolabor::process_controller spatial_controller{0.5, 0.1, 12, 4};
+
+/** 后轮转向速度的保守估计（rad/s），用于规划段间衔接 */
+const auto rudder_speed = pi_f / 2;
+
+/** 连续运动段和 S 形曲线动作的控制周期 */
+constexpr auto segment_period = std::chrono::milliseconds(20);
+
+/** S 形曲线动作按位移偏差修正速度的增益（1/s） */
+constexpr auto profile_gain = 2.0;
+
+/** 里程度量（两轮里程之和）与较快轮里程之比 */
+double spatium_scale(physical target, const chassis_config_t &config) {
+    const auto wheels = physical_to_wheels({1, target.rudder}, &config);
+    const auto left   = std::abs(wheels.left * config.left_radius),
+               right  = std::abs(wheels.right * config.right_radius);
+    return (left + right) / std::max(left, right);
+}
+
+/**
+ * 执行动作
+ *
+ * 加加速度参数为 0 时按过程控制器的梯形曲线调速；
+ * 否则按 S 形曲线调速：限时动作直接按时间求值，
+ * 限里程动作从后轮转到位时开始计时，并按实际里程与曲线的偏差修正速度
+ */
 handler_t block(double v,
                 double w,
                 double limit,
+                bool timing,
                 const autolabor::process_controller &controller,
                 std::function<double(ptr_t)> &&measure,
                 double &progress) noexcept {
@@ -495,24 +1502,39 @@ handler_t block(double v,
     
     weak_lock_guard<decltype(action_mutex)> lock(action_mutex);
     if (!lock) {
-        exceptions.set(id, action_conflict);
+        exceptions.set(id, error_code::action_conflict, action_conflict);
         return id;
     }
+    acting_guard _;
     
     auto rest   = 1 - progress;
     auto paused = true;
     try {
-        auto config = chassis_ptr.read<chassis_config_t>([](ptr_t ptr) { return ptr->config; });
+        auto config = chassis_ptr.read([](ptr_t ptr) { return ptr->config; });
         auto target = velocity_to_physical(velocity{static_cast<float>(v),
                                                     static_cast<float>(w)},
                                            &config);
         
         autolabor::process_t process{0, 0, target.speed};
         
+        const double acceleration = chassis_ptr.read([](ptr_t ptr) { return ptr->acceleration; }),
+                     jerk         = chassis_ptr.read([](ptr_t ptr) { return ptr->jerk; });
+        
+        const auto shaped = jerk > 0 && target.speed != 0;
+        const auto scale  = timing ? 1 : spatium_scale(target, config);
+        const auto plan   = [&] {
+            return timing
+                   ? autolabor::jerk_profile_t::of_duration(limit, target.speed, acceleration, jerk)
+                   : autolabor::jerk_profile_t::of_distance(limit / scale, target.speed, acceleration, jerk);
+        };
+        auto profile = plan();
+        auto start   = autolabor::now();
+        auto aligned = false;  // 后轮已转到位，曲线开始计时
+        
         while (true) {
             if (cancel_flag) {
-                chassis_ptr.read<void>([](ptr_t ptr) { ptr->set_target(0, NAN); });
-                throw std::logic_error("action canceled");
+                chassis_ptr.read([](ptr_t ptr) { ptr->set_target(0, NAN); });
+                throw coded_error(error_code::action_canceled, action_canceled);
             }
             
             if (paused) {
@@ -520,28 +1542,14 @@ handler_t block(double v,
                 if (!(paused = pause_flag)) {
                     process.begin = chassis_ptr.read(measure);
                     process.end   = process.begin + limit;
+                    if (shaped) {
+                        profile = plan();
+                        aligned = false;
+                    }
                 }
             } else {
-                auto finished = chassis_ptr.read<bool>([&](ptr_t ptr) {
-                    constexpr static auto
-                        unknown  = autolabor::pm1::node_state_t::unknown,
-                        enabled  = autolabor::pm1::node_state_t::enabled,
-                        disabled = autolabor::pm1::node_state_t::disabled;
-                    
-                    // 检查状态
-                    auto states = ptr->state().states;
-                    if (std::find(states.begin(), states.end(), unknown) != states.end()) {
-                        std::stringstream builder;
-                        builder << "critical error: error state -> [ecu0|ecu1|tcu|vcu] = ["
-                                << static_cast<int>(states[0]) << '|'
-                                << static_cast<int>(states[1]) << '|'
-                                << static_cast<int>(states[2]) << '|'
-                                << static_cast<int>(states[3]) << ']';
-                        throw std::logic_error(builder.str());
-                    }
-                    if (std::find(states.begin(), states.end(), disabled) != states.end()
-                        && ptr->target_state() != enabled)
-                        throw std::logic_error("chassis is locked");
+                auto finished = chassis_ptr.read([&](ptr_t ptr) {
+                    check_action_state(ptr);
                     
                     // 检查任务进度
                     auto current = measure(ptr);
@@ -554,24 +1562,41 @@ handler_t block(double v,
                         limit *= (1 - sub); // 子任务规模缩减
                         rest *= (1 - sub);  // 子任务比例缩减
                         ptr->set_target(0, target.rudder);
-                    } else
-                        ptr->set_target(std::abs(target.rudder - ptr->rudder().position) < pi_f / 120
-                                        ? controller(process, current)
-                                        : 0,
-                                        target.rudder);
+                    } else if (std::abs(target.rudder - ptr->rudder().position) >= pi_f / 120)
+                        set_action_target(ptr, 0, target.rudder);
+                    else if (!shaped)
+                        set_action_target(ptr, controller(process, current), target.rudder);
+                    else if (timing)
+                        set_action_target(ptr, std::copysign(profile.speed(current - process.begin), target.speed), target.rudder);
+                    else {
+                        if (!aligned) {
+                            aligned = true;
+                            start   = autolabor::now();
+                        }
+                        // 里程计读数滞后，与读数时刻的曲线位置比较
+                        const auto time    = autolabor::duration_seconds(autolabor::now() - start),
+                                   sampled = autolabor::duration_seconds(ptr->odometry().time - start);
+                        const auto error   = profile.position(sampled) - (current - process.begin) / scale;
+                        // 曲线走完仍未到达时以终止速度补足
+                        const auto floor = time < profile.duration() ? 0 : controller.speed_end;
+                        const auto speed = std::max(floor, std::min(profile.speed(time) + profile_gain * error, profile.peak()));
+                        set_action_target(ptr, std::copysign(speed, target.speed), target.rudder);
+                    }
                     return false;
                 });
                 
                 if (finished)
                     break;
             }
-            using namespace std::chrono_literals;
-            std::this_thread::sleep_for(50ms);
+            if (shaped)
+                wait_action_signal(paused, segment_period);
+            else
+                wait_action_signal(paused);
         }
         
-        chassis_ptr.read<void>([](ptr_t ptr) { ptr->set_target(0, NAN); });
+        chassis_ptr.read([](ptr_t ptr) { ptr->set_target(0, NAN); });
     } catch (const std::exception &e) {
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     
     return id;
@@ -597,16 +1622,16 @@ drive_spatial(double v,
     double     width;
     
     try {
-        origin = chassis_ptr.read<odometry_t<>>([](ptr_t ptr) { return ptr->odometry().value; });
-        width  = chassis_ptr.read<double>([](ptr_t ptr) { return ptr->config.width; });
+        origin = chassis_ptr.read([](ptr_t ptr) { return ptr->odometry().value; });
+        width  = chassis_ptr.read([](ptr_t ptr) { return ptr->config.width; });
     } catch (std::exception &e) {
         handler_t id = ++task_id;
-        exceptions.set(id, e.what());
+        set_exception(id, e);
         return id;
     }
     
-    return block(v, w, calculate_spatium(spatium, angle, width),
-                 {0.5, 0.1, 12, 4},
+    return block(v, w, calculate_spatium(spatium, angle, width), false,
+                 spatial_controller,
                  [origin, width](ptr_t ptr) {
                      auto odometry = ptr->odometry().value - origin;
                      return calculate_spatium(odometry.s, odometry.a, width);
@@ -625,6 +1650,115 @@ drive_spatial_c(double v,
     return drive_spatial(v, w, spatium, angle, *progress);
 }
 
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_segments(const segment_t *segments,
+               unsigned int count,
+               double &progress) noexcept {
+    handler_t id = ++task_id;
+    progress = 0;
+    
+    weak_lock_guard<decltype(action_mutex)> lock(action_mutex);
+    if (!lock) {
+        exceptions.set(id, error_code::action_conflict, action_conflict);
+        return id;
+    }
+    acting_guard _;
+    
+    try {
+        if (count && !segments)
+            throw coded_error(error_code::undefined_parameter, "null segment pointer");
+        
+        const auto config = chassis_ptr.read([](ptr_t ptr) { return ptr->config; });
+        const auto width  = config.width;
+        const auto plan   = [&] {
+            std::vector<autolabor::pm1::segment_plan_t::segment_t> temp;
+            for (unsigned int i = 0; i < count; ++i) {
+                const auto &segment = segments[i];
+                if (segment.spatium < 0 || segment.angle < 0)
+                    throw coded_error(error_code::undefined_parameter, "segment target must be positive");
+                const auto length = calculate_spatium(segment.spatium, segment.angle, width);
+                if (length == 0) continue;
+                const auto target = velocity_to_physical(velocity{static_cast<float>(segment.v),
+                                                                  static_cast<float>(segment.w)},
+                                                         &config);
+                if (target.speed == 0)
+                    throw coded_error(error_code::undefined_parameter, "segment never complete");
+                temp.push_back({target, length});
+            }
+            const auto optimize_width = chassis_ptr.read([](ptr_t ptr) { return ptr->optimize_width; });
+            return autolabor::pm1::segment_plan_t(std::move(temp), spatial_controller, optimize_width, rudder_speed);
+        }();
+        
+        size_t     index   = 0;
+        double     base    = 0,  // 当前段起点的累计里程度量
+                   restart = 0;  // 最近一次起步的累计里程度量
+        odometry_t origin  = chassis_ptr.read([](ptr_t ptr) { return ptr->odometry().value; });
+        auto       paused  = true;
+        
+        while (index < plan.size()) {
+            if (cancel_flag) {
+                chassis_ptr.read([](ptr_t ptr) { ptr->set_target(0, NAN); });
+                throw coded_error(error_code::action_canceled, action_canceled);
+            }
+            
+            chassis_ptr.read([&](ptr_t ptr) {
+                check_action_state(ptr);
+                
+                // 检查任务进度，越过终点的部分计入下一段
+                const auto odometry = ptr->odometry().value;
+                const auto delta    = odometry - origin;
+                auto       x        = base + calculate_spatium(delta.s, delta.a, width);
+                while (index < plan.size() && x >= plan.begin(index + 1)) {
+                    base   = x;
+                    origin = odometry;
+                    ++index;
+                }
+                progress = std::min(1.0, x / plan.length());
+                if (index == plan.size()) return;
+                
+                const auto &target = plan.target(index);
+                if (paused) {
+                    // 检查恢复标记
+                    if (!(paused = pause_flag)) restart = x;
+                } else if ((paused = pause_flag)) {
+                    ptr->set_target(0, target.rudder);
+                    return;
+                }
+                if (paused) return;
+                
+                // 需要停车衔接的段等后轮转到位再起步，平滑衔接的段交给底盘的转角优化
+                const auto aligned = std::abs(target.rudder - ptr->rudder().position) < pi_f / 120;
+                if (plan.stop_before(index) && !aligned)
+                    restart = x;
+                const auto speed = plan.stop_before(index) && !aligned
+                                   ? 0
+                                   : plan.speed(index, x, restart);
+                set_action_target(ptr, target.speed > 0 ? +speed : -speed, target.rudder);
+            });
+            
+            if (index < plan.size())
+                wait_action_signal(paused, segment_period);
+        }
+        
+        chassis_ptr.read([](ptr_t ptr) { ptr->set_target(0, NAN); });
+    } catch (const std::exception &e) {
+        set_exception(id, e);
+    }
+    
+    return id;
+}
+
+handler_t
+STD_CALL
+autolabor::pm1::native::
+drive_segments_c(const segment_t *segments,
+                 unsigned int count,
+                 double *progress) noexcept {
+    return drive_segments(segments, count, *progress);
+}
+
 handler_t
 STD_CALL
 autolabor::pm1::native::
@@ -632,7 +1766,7 @@ drive_timing(double v,
              double w,
              double time,
              double &progress) noexcept {
-    return block(v, w, time,
+    return block(v, w, time, true,
                  {0.5, 0.1, 5, 2},
                  [](ptr_t) {
                      return std::chrono::duration_cast<seconds_floating>(
@@ -651,11 +1785,12 @@ adjust_rudder(double offset,
     
     weak_lock_guard<decltype(action_mutex)> lock(action_mutex);
     if (!lock) {
-        exceptions.set(id, action_conflict);
+        exceptions.set(id, error_code::action_conflict, action_conflict);
         return id;
     }
+    acting_guard _;
     
-    const auto total = chassis_ptr.read<double>([=](ptr_t ptr) {
+    const auto total = chassis_ptr.read([=](ptr_t ptr) {
         ptr->set_target(0, offset);
         return std::abs(offset - ptr->rudder().position);
     });
@@ -664,15 +1799,16 @@ adjust_rudder(double offset,
         while (true) {
             using namespace std::chrono_literals;
             
+            const bool paused = pause_flag;
             if (cancel_flag) {
-                chassis_ptr.read<void>([](ptr_t ptr) { ptr->set_target(0, NAN); });
-                throw std::logic_error("action canceled");
+                chassis_ptr.read([](ptr_t ptr) { ptr->set_target(0, NAN); });
+                throw coded_error(error_code::action_canceled, action_canceled);
             }
             
-            if (pause_flag)
-                chassis_ptr.read<void>([](ptr_t ptr) { ptr->set_target(0, NAN); });
+            if (paused)
+                chassis_ptr.read([](ptr_t ptr) { ptr->set_target(0, NAN); });
             else {
-                auto finished = chassis_ptr.read<bool>([&](ptr_t ptr) {
+                auto finished = chassis_ptr.read([&](ptr_t ptr) {
                     auto difference = std::abs(offset - ptr->rudder().position);
                     
                     if (difference < pi_f / 120) {
@@ -690,10 +1826,10 @@ adjust_rudder(double offset,
                 if (finished)
                     break;
             }
-            std::this_thread::sleep_for(50ms);
+            wait_action_signal(paused);
         }
     } catch (std::exception &e) {
-        exceptions.set(id, e.what());
+        set_exception(id, e);
     }
     
     return id;
@@ -702,7 +1838,16 @@ adjust_rudder(double offset,
 void
 STD_CALL
 autolabor::pm1::native::
-set_paused(bool paused) noexcept { pause_flag = paused; }
+set_paused(bool paused) noexcept {
+    // 定时控制量和路径跟随不占用动作锁，暂停时单独停车
+    try {
+        chassis_ptr.read([paused](ptr_t ptr) {
+            ptr->paused = paused;
+            if (paused && (ptr->schedule.size() || ptr->path.is_active())) ptr->stop();
+        });
+    } catch (...) {}
+    raise_action_signal(pause_flag, paused, paused);
+}
 
 bool
 STD_CALL
@@ -713,7 +1858,16 @@ void
 STD_CALL
 autolabor::pm1::native::
 cancel_action() noexcept {
-    cancel_flag = true;
+    // 定时控制量和路径跟随不占用动作锁，单独清除并停车
+    try {
+        chassis_ptr.read([](ptr_t ptr) {
+            const auto scheduled = ptr->schedule.size() > 0;
+            ptr->schedule.clear();
+            const auto following = ptr->path.clear();
+            if (scheduled || following) ptr->stop();
+        });
+    } catch (...) {}
+    raise_action_signal(cancel_flag, true, true);
     {
         std::lock_guard<std::mutex> wait(action_mutex);
     }
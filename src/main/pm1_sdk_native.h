@@ -18,12 +18,139 @@ namespace autolabor {
         namespace native {
             using handler_t = unsigned int;
             
+            /**
+             * 连接信息
+             */
+            struct connection_info_t {
+                unsigned int reconnect_count; // 自动重连成功次数
+                double       last_outage,     // 最近一次断线时长（秒）
+                             max_outage,      // 最长断线时长（秒）
+                             total_outage;    // 累计断线时长（秒）
+                int          latency_timer,   // 适配器接收延迟定时器（毫秒），-1 表示不支持
+                             original_latency_timer; // 调整前的定时器（毫秒），-1 表示未调整
+                double       planned_utilisation,    // 按轮询计划估算的链路占用率
+                             utilisation,            // 最近一秒实测的链路占用率，收发两个方向中较大者
+                             odometry_period,        // 降频后的里程计查询周期（秒）
+                             state_period,           // 降频后的状态查询周期（秒）
+                             control_rate;           // 最近一秒实测的控制频率（Hz）
+                unsigned long long stale_rudder_cycles; // 舵轮读数过时（至少丢了一次应答）的控制周期数
+            };
+            
+            /**
+             * 节点往返时间统计
+             *
+             * 最短、平均和 99% 分位值取自最近 128 次应答
+             */
+            struct rtt_stats_t {
+                unsigned long long samples;  // 累计配对成功的应答数
+                unsigned long long lost;     // 累计未得到应答的询问数
+                double             min,      // 最短往返时间（秒）
+                                   avg,      // 平均往返时间（秒）
+                                   p99,      // 99% 分位往返时间（秒）
+                                   timeout,  // 由往返时间推算的节点状态超时（秒）
+                                   max_rate; // 应答不与下一次询问交叠的最高询问频率（Hz），无样本时为 0
+            };
+            
+            /**
+             * 路点，坐标与 get_odometry 同系
+             */
+            struct waypoint_t { double x, y; };
+            
+            /**
+             * 路径跟随状态
+             */
+            struct path_stats_t {
+                unsigned long long samples;   // 横向误差样本数，每个控制周期一个
+                double             last,      // 最近一次横向误差（m），路径左侧为正
+                                   rms,       // 横向误差均方根（m）
+                                   max,       // 横向误差绝对值最大值（m）
+                                   residual;  // 结束跟随时到终点的距离（m），尚未结束时为 NAN；
+                                              // 越过终点结束时可能大于到达判定距离
+                unsigned int       waypoints; // 尚未驶过的路点数
+                bool               active;    // 是否正在跟随，到达或越过终点、清除后为 false
+            };
+            
+            /**
+             * 运动段，参数同 drive_spatial
+             */
+            struct segment_t {
+                double v,       // 线速度（m/s）
+                       w,       // 角速度（rad/s）
+                       spatium, // 路程约束（m）
+                       angle;   // 转角约束（rad）
+            };
+            
+            /**
+             * 定时控制量
+             */
+            struct timed_command_t {
+                double stamp,  // 生效时刻（秒），与遥测时间戳同源
+                       first,  // 线速度 v（m/s）或后轮速度 speed（m/s）
+                       second; // 角速度 w（rad/s）或后轮转角 rudder（rad）
+            };
+            
+            /**
+             * 周期查询得到的应答
+             */
+            struct polled_t {
+                double        stamp;   // 应答到达的时间戳（秒），未收到时为 0
+                unsigned char data[8]; // 应答数据域
+            };
+            
+            /**
+             * 遥测信息
+             *
+             * 所有字段取自同一时刻的快照
+             */
+            struct telemetry_t {
+                unsigned long long seq;             // 快照序号，序号不变表示数据未更新
+                double             stamp,           // 时间戳（秒）
+                                   s, a,            // 里程：路程、转角
+                                   x, y, theta,     // 里程：位姿
+                                   left_position,   // 左轮转角（弧度）
+                                   left_speed,      // 左轮角速度（弧度/秒）
+                                   right_position,  // 右轮转角（弧度）
+                                   right_speed,     // 右轮角速度（弧度/秒）
+                                   rudder_position, // 后轮方向角（弧度）
+                                   rudder_speed,    // 后轮方向角速度（弧度/秒）
+                                   battery_percent; // 电池电量
+                unsigned char      states[4];       // 节点状态：[ecu0|ecu1|tcu|vcu]
+            };
+            
+            /**
+             * 遥测订阅回调
+             *
+             * 在 SDK 的串口读线程中调用，帧解析完成后立即触发：
+             * 延迟只包含串口传输和解析，不包含任何轮询周期。
+             * 回调阻塞期间不会解析新的帧，也不会发送控制指令，
+             * 因此回调必须尽快返回；在回调中调用 initialize 或 shutdown 会返回错误，不执行
+             *
+             * @param telemetry 更新后的遥测快照，仅在回调期间有效
+             * @param topics    本次变化的项目，见 topic
+             * @param user      订阅时传入的用户指针
+             */
+            using telemetry_callback_t = void (STD_CALL *)(const telemetry_t *telemetry,
+                                                           unsigned int topics,
+                                                           void *user);
+            
             /**
              * 从错误管理器获取错误信息
+             *
+             * 返回的字符串属于调用线程，在本线程下次调用前有效
              */
             DLL_EXPORT const char *STD_CALL
             get_error_info(handler_t) noexcept;
             
+            /**
+             * 从错误管理器获取错误码
+             *
+             * 错误信息保存在定长的环中，查询太迟、信息已被之后的错误覆盖时返回 other
+             *
+             * @return 0 表示无错误，其他值见 error_code
+             */
+            DLL_EXPORT unsigned int STD_CALL
+            get_error_code(handler_t) noexcept;
+            
             /**
              * 从错误管理器移除错误信息
              */
@@ -41,6 +168,27 @@ namespace autolabor {
              */
             DLL_EXPORT const char *STD_CALL
             get_connected_port() noexcept;
+            
+            /**
+             * 开关断线自动重连
+             *
+             * 重连时重新打开同一设备（或同一 USB 序列号的设备），
+             * 保留里程计和参数
+             */
+            DLL_EXPORT handler_t STD_CALL
+            set_auto_reconnect(bool) noexcept;
+            
+            /**
+             * 获取连接信息（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_connection_info_c(connection_info_t *info) noexcept;
+            
+            /**
+             * 获取连接信息
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_connection_info(connection_info_t &info) noexcept;
     
             /**
              * 初始化（指针版）
@@ -56,6 +204,30 @@ namespace autolabor {
             initialize(const char *port,
                        double &progress) noexcept;
             
+            /**
+             * 以指定串口设置初始化（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            initialize_ex_c(const char *port,
+                            unsigned int baud_rate,
+                            bool low_latency,
+                            double *progress) noexcept;
+            
+            /**
+             * 以指定串口设置初始化
+             *
+             * @param port        串口名字，为空则自动探测
+             * @param baud_rate   波特率，非标准值按任意波特率设置
+             * @param low_latency 低延迟模式：请求驱动关闭接收缓冲延迟，并按帧唤醒读线程；
+             *                    USB 转串口适配器支持时把接收延迟定时器调到 1 ms，关闭时恢复
+             * @param progress    进度
+             */
+            DLL_EXPORT handler_t STD_CALL
+            initialize_ex(const char *port,
+                          unsigned int baud_rate,
+                          bool low_latency,
+                          double &progress) noexcept;
+            
             /**
              * 关闭
              */
@@ -110,6 +282,141 @@ namespace autolabor {
             DLL_EXPORT handler_t STD_CALL
             get_rudder(double &rudder) noexcept;
             
+            /**
+             * 获取遥测快照（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_telemetry_c(telemetry_t *telemetry) noexcept;
+            
+            /**
+             * 获取遥测快照
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_telemetry(telemetry_t &telemetry) noexcept;
+            
+            /**
+             * 设置对话的查询周期
+             *
+             * 查询与状态查询同属最低优先级，链路繁忙时降频
+             *
+             * @param dialog 对话，见 dialog_id
+             * @param period 查询周期（秒），不大于 0 时停止查询
+             */
+            DLL_EXPORT handler_t STD_CALL
+            set_poll_period(unsigned int dialog, double period) noexcept;
+            
+            /**
+             * 获取周期查询得到的最近一次应答（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_polled_c(unsigned int dialog, polled_t *value) noexcept;
+            
+            /**
+             * 获取周期查询得到的最近一次应答
+             *
+             * @param dialog 对话，见 dialog_id
+             * @param value  应答
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_polled(unsigned int dialog, polled_t &value) noexcept;
+            
+            /**
+             * 获取节点往返时间统计（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_rtt_stats_c(unsigned int node, rtt_stats_t *stats) noexcept;
+            
+            /**
+             * 获取节点往返时间统计
+             *
+             * @param node  节点序号：[ecu0|ecu1|tcu|vcu]
+             * @param stats 统计结果
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_rtt_stats(unsigned int node, rtt_stats_t &stats) noexcept;
+            
+            /**
+             * 开始向共享内存环形缓冲区发布遥测快照
+             *
+             * 每次快照更新都写入一条记录，写入不等待任何读者；
+             * 其他进程用 pm1_telemetry_reader 只读连接。仅支持 Linux
+             *
+             * @param name     POSIX 共享内存名字，如 "/pm1_telemetry"，同名的旧共享内存会被移除
+             * @param capacity 缓冲区能容纳的记录数
+             */
+            DLL_EXPORT handler_t STD_CALL
+            start_telemetry_ring(const char *name, unsigned int capacity) noexcept;
+            
+            /**
+             * 停止发布并移除共享内存
+             */
+            DLL_EXPORT handler_t STD_CALL
+            stop_telemetry_ring() noexcept;
+            
+            /**
+             * 订阅遥测更新（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            subscribe_c(unsigned int topics,
+                        unsigned int decimation,
+                        telemetry_callback_t callback,
+                        void *user,
+                        unsigned int *subscription) noexcept;
+            
+            /**
+             * 订阅遥测更新
+             *
+             * 里程计约 20 Hz，后轮方向角约 50 Hz，节点状态和电量至多 1 Hz 变化
+             *
+             * @param topics       订阅的项目，见 topic，可按位组合
+             * @param decimation   抽取倍数，每 decimation 次更新回调一次，0 视为 1
+             * @param callback     回调函数
+             * @param user         传给回调的用户指针
+             * @param subscription 订阅号，用于取消订阅
+             */
+            DLL_EXPORT handler_t STD_CALL
+            subscribe(unsigned int topics,
+                      unsigned int decimation,
+                      telemetry_callback_t callback,
+                      void *user,
+                      unsigned int &subscription) noexcept;
+            
+            /**
+             * 取消订阅
+             *
+             * 返回后回调不会再被调用（在回调中取消其他订阅除外）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            unsubscribe(unsigned int subscription) noexcept;
+            
+            /**
+             * 等待新的遥测数据（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            wait_telemetry_c(unsigned int topics,
+                             unsigned long long after_seq,
+                             double timeout,
+                             telemetry_t *telemetry) noexcept;
+            
+            /**
+             * 等待新的遥测数据
+             *
+             * 阻塞到 topics 中任一项目在序号 after_seq 之后更新，然后返回最新快照；
+             * 把返回的 seq 作为下一次的 after_seq，不会重复取得同一次更新。
+             * 只保存最新的快照，两次调用之间发生的多次更新只能取得最后一次，
+             * 需要逐个处理时请检查 seq 是否连续，或改用 subscribe
+             *
+             * @param topics    等待的项目，见 topic，可按位组合
+             * @param after_seq 已经取得的快照序号，0 表示取得任意一次更新
+             * @param timeout   超时时间（秒），超过约 3 年（含无穷大）按 3 年计，NaN 与负值按 0 计
+             * @param telemetry 遥测快照
+             */
+            DLL_EXPORT handler_t STD_CALL
+            wait_telemetry(unsigned int topics,
+                           unsigned long long after_seq,
+                           double timeout,
+                           telemetry_t &telemetry) noexcept;
+            
             /**
              * 获取里程计值（指针版）
              */
@@ -138,6 +445,47 @@ namespace autolabor {
             DLL_EXPORT handler_t STD_CALL
             set_command_enabled(bool) noexcept;
             
+            /**
+             * 设置控制频率
+             *
+             * 为 0 时（默认）控制节拍跟随舵轮应答；
+             * 否则由独立线程按固定频率发出控制指令，丢失个别应答时照常运行，
+             * 舵轮转角按读数的年龄和往返时间外推
+             *
+             * @param rate 控制频率（Hz），0 或 1 ~ 1000
+             */
+            DLL_EXPORT handler_t STD_CALL
+            set_control_rate(double rate) noexcept;
+            
+            /**
+             * 开关舵轮转角预测
+             *
+             * 打开后按舵轮转动速度和往返时间外推控制帧到达时的转角，
+             * 速度门控和轮速分配都按预测转角计算；默认关闭。
+             * 控制频率大于 0 时总是预测，此时关闭不生效
+             */
+            DLL_EXPORT handler_t STD_CALL
+            set_rudder_prediction(bool) noexcept;
+            
+            /**
+             * 开关延迟推算位姿
+             *
+             * 打开后读线程只记录两轮的编码器增量，
+             * 读取里程计或推送订阅的遥测时才从上次推算的位置接着推算；默认关闭
+             */
+            DLL_EXPORT handler_t STD_CALL
+            set_lazy_odometry(bool) noexcept;
+            
+            /**
+             * 开关两轮读数插值
+             *
+             * 两轮的应答先后到达，默认按同一时刻的读数配对；
+             * 打开后后应答的一轮按前后两次读数插值到先应答一轮的时刻，
+             * 适用于各轮在应答时才采样的情形；默认关闭
+             */
+            DLL_EXPORT handler_t STD_CALL
+            set_wheel_interpolation(bool) noexcept;
+            
             /**
              * 设置使能状态
              */
@@ -157,6 +505,9 @@ namespace autolabor {
             
             /**
              * 按物理模型参数设置目标控制量
+             *
+             * 以下三个函数可在任意多个线程中高频调用，最后写入的目标生效，不会因竞争而失败；
+             * 动作执行期间返回 action_conflict，不与动作争夺控制量
              */
             DLL_EXPORT handler_t STD_CALL
             drive_physical(double speed, double rudder) noexcept;
@@ -173,6 +524,82 @@ namespace autolabor {
             DLL_EXPORT handler_t STD_CALL
             drive_velocity(double v, double w) noexcept;
             
+            /**
+             * 按速度矢量安排定时控制量
+             *
+             * 控制量在发送时刻离生效时刻最近的控制周期发出；
+             * 队列中生效时刻不早于本批最早时刻的控制量先被删除，
+             * 因此重新规划时传入新的队尾即可原子地替换旧规划。
+             * 到期的控制量覆盖之前 drive_* 设置的目标，正在跟随路径时被路径跟随覆盖；
+             * 暂停期间控制量照常按时出队但速度为零，cancel_action 清空队列
+             *
+             * @param commands 控制量 {stamp, v, w}，不要求有序
+             * @param count    控制量数量
+             */
+            DLL_EXPORT handler_t STD_CALL
+            schedule_velocity(const timed_command_t *commands, unsigned int count) noexcept;
+            
+            /**
+             * 按物理模型参数安排定时控制量
+             *
+             * 规则同 schedule_velocity
+             *
+             * @param commands 控制量 {stamp, speed, rudder}，不要求有序
+             * @param count    控制量数量
+             */
+            DLL_EXPORT handler_t STD_CALL
+            schedule_physical(const timed_command_t *commands, unsigned int count) noexcept;
+            
+            /**
+             * 清空尚未发出的定时控制量
+             */
+            DLL_EXPORT handler_t STD_CALL
+            clear_schedule() noexcept;
+            
+            /**
+             * 开始跟随路径
+             *
+             * 底盘控制周期以最新的里程计按纯追踪计算目标控制量，到达或越过终点后停车；
+             * 暂停期间停车并停止推进，恢复后接着跟随；
+             * 替换原有路径，横向误差统计清零
+             *
+             * @param points    路点，至多 1024 个
+             * @param count     路点数
+             * @param speed     线速度（m/s）
+             * @param lookahead 前视距离（m）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            follow_path(const waypoint_t *points,
+                        unsigned int count,
+                        double speed,
+                        double lookahead) noexcept;
+            
+            /**
+             * 在跟随的路径末尾追加路点
+             *
+             * 已驶过的路点不占容量；已经到达终点时接着跟随新路点
+             */
+            DLL_EXPORT handler_t STD_CALL
+            append_path(const waypoint_t *points, unsigned int count) noexcept;
+            
+            /**
+             * 停止跟随路径并停车
+             */
+            DLL_EXPORT handler_t STD_CALL
+            clear_path() noexcept;
+            
+            /**
+             * 获取路径跟随状态（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_path_stats_c(path_stats_t *stats) noexcept;
+            
+            /**
+             * 获取路径跟随状态
+             */
+            DLL_EXPORT handler_t STD_CALL
+            get_path_stats(path_stats_t &stats) noexcept;
+            
             /**
              * 计算里程度量
              */
@@ -201,6 +628,29 @@ namespace autolabor {
                             double angle,
                             double *progress) noexcept;
             
+            /**
+             * 连续执行多个运动段
+             *
+             * 各段首尾相接，速度跨段前瞻规划：
+             * 后轮转角变化不大且方向不变的段间不停车，只在最后一段的终点停车
+             *
+             * @param segments 运动段
+             * @param count    段数
+             * @param progress 进度
+             */
+            DLL_EXPORT handler_t STD_CALL
+            drive_segments(const segment_t *segments,
+                           unsigned int count,
+                           double &progress) noexcept;
+            
+            /**
+             * 连续执行多个运动段（指针版）
+             */
+            DLL_EXPORT handler_t STD_CALL
+            drive_segments_c(const segment_t *segments,
+                             unsigned int count,
+                             double *progress) noexcept;
+            
             /**
              * 按时间约束行驶
              */
@@ -232,7 +682,7 @@ namespace autolabor {
             /**
              * 取消正在执行的动作
              *
-             * 当成功获取锁，认为所有动作已取消
+             * 同时清空定时控制量、停止路径跟随；当成功获取锁，认为所有动作已取消
              */
             DLL_EXPORT void STD_CALL
             cancel_action() noexcept;
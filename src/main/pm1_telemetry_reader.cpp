@@ -0,0 +1,46 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include "pm1_telemetry_reader.h"
+
+#include <utilities/shared_memory/shm_ring.hpp>
+
+using reader_t = autolabor::shm_ring_reader<autolabor::pm1::native::telemetry_t>;
+
+void *
+STD_CALL
+autolabor::pm1::native::
+open_telemetry_reader(const char *name) noexcept {
+    try {
+        return new reader_t(name);
+    } catch (std::exception &) {
+        return nullptr;
+    }
+}
+
+int
+STD_CALL
+autolabor::pm1::native::
+read_telemetry(void *reader,
+               telemetry_t *telemetry,
+               unsigned long long *lost) noexcept {
+    uint64_t count = 0;
+    switch (static_cast<reader_t *>(reader)->read(*telemetry, count)) {
+        case reader_t::result_t::record:
+            return 1;
+        case reader_t::result_t::empty:
+            return 0;
+        case reader_t::result_t::overrun:
+            if (lost) *lost = count;
+            return -1;
+    }
+    return 0;
+}
+
+void
+STD_CALL
+autolabor::pm1::native::
+close_telemetry_reader(void *reader) noexcept {
+    delete static_cast<reader_t *>(reader);
+}
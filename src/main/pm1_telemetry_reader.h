@@ -0,0 +1,47 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_TELEMETRY_READER_H
+#define PM1_SDK_TELEMETRY_READER_H
+
+#include "pm1_sdk_native.h"
+
+namespace autolabor {
+    namespace pm1 {
+        namespace native {
+            /**
+             * 连接到 start_telemetry_ring 创建的共享内存（只读）
+             *
+             * 从连接之后写入的记录开始读取
+             *
+             * @param name 共享内存名字
+             * @return 读者，失败时为空
+             */
+            DLL_EXPORT void *STD_CALL
+            open_telemetry_reader(const char *name) noexcept;
+            
+            /**
+             * 读取下一条遥测快照，不阻塞，也不阻塞写者
+             *
+             * @param reader    读者
+             * @param telemetry 遥测快照
+             * @param lost      读得太慢、记录被覆盖时丢失的条数
+             * @return 1：读到记录；0：没有新记录；-1：记录被覆盖，已跳到最旧的有效记录
+             */
+            DLL_EXPORT int STD_CALL
+            read_telemetry(void *reader,
+                           telemetry_t *telemetry,
+                           unsigned long long *lost) noexcept;
+            
+            /**
+             * 断开连接
+             */
+            DLL_EXPORT void STD_CALL
+            close_telemetry_reader(void *reader) noexcept;
+        }
+    }
+}
+
+
+#endif //PM1_SDK_TELEMETRY_READER_H
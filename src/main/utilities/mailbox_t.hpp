@@ -0,0 +1,138 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_MAILBOX_T_HPP
+#define PM1_SDK_MAILBOX_T_HPP
+
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+/**
+ * 最新值信箱
+ * 多写者、多读者，无锁，不分配内存
+ *
+ * 写者按票号取得版本号，占用任意一个空闲且不受保护的槽写入；
+ * 已发布的最新版本所在的槽受保护，写者不会占用，因此读者总能完整读到它，
+ * 读者扫描所有槽取版本最新的完整数据，不等待写者，读到的版本单调不减；
+ * 票号旧于已发布版本的写入直接丢弃。
+ * 只有槽数减一个写者同时处于写入中途时，新的写者才需要让出时间片。
+ * 数据按字存放在原子量中，读者不会读到半新半旧的值
+ *
+ * @tparam t     数据类型，必须可平凡复制
+ * @tparam count 槽数
+ */
+template<class t, size_t count = 4>
+class mailbox_t {
+    static_assert(std::is_trivially_copyable<t>::value, "mailbox value must be trivially copyable");
+    static_assert(count >= 2, "mailbox needs at least two slots");
+    
+    constexpr static size_t words = (sizeof(t) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    using buffer_t = std::array<uint64_t, words>;
+    
+    /** 独占缓存行的槽 */
+    struct alignas(64) slot_t {
+        std::atomic<uint64_t>                    sequence{0}; // 奇数表示正在写
+        std::atomic<uint64_t>                    version{0};  // 槽内数据的版本，0 表示空
+        std::array<std::atomic<uint64_t>, words> data{};
+    };
+    
+    std::atomic<uint64_t>         ticket{0};
+    mutable std::atomic<uint64_t> latest{0}; // 已发布的最新版本，读者也会推进
+    std::array<slot_t, count>     slots;
+    
+    /** 推进已发布的最新版本 */
+    void publish(uint64_t version) const {
+        auto last = latest.load(std::memory_order_relaxed);
+        while (last < version && !latest.compare_exchange_weak(last, version, std::memory_order_release));
+    }
+    
+    /** 读出一个槽，正在写、为空或读取期间被改写时返回 0 */
+    static uint64_t load(const slot_t &slot, buffer_t &buffer) {
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1u) return 0;
+        
+        const auto version = slot.version.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < words; ++i)
+            buffer[i] = slot.data[i].load(std::memory_order_relaxed);
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == sequence ? version : 0;
+    }
+
+public:
+    /**
+     * 写入
+     *
+     * @param value 新值
+     * @return 新值的版本号
+     */
+    uint64_t write(const t &value) noexcept {
+        const auto version = ++ticket;
+        
+        buffer_t buffer{};
+        std::memcpy(buffer.data(), reinterpret_cast<const unsigned char *>(&value), sizeof(t));
+        
+        while (true) {
+            // 更新的值已经发布，这次写入没有意义
+            const auto newest = latest.load(std::memory_order_acquire);
+            if (newest > version) return version;
+            
+            for (auto &slot : slots) {
+                // 跳过正在写的槽，以及最新发布或写完待发布的槽
+                auto       sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto old      = slot.version.load(std::memory_order_acquire);
+                if (sequence & 1u || (old && old >= newest)) continue;
+                if (!slot.sequence.compare_exchange_strong(sequence, sequence + 1)) continue;
+                
+                slot.version.store(version, std::memory_order_relaxed);
+                for (size_t i = 0; i < words; ++i)
+                    slot.data[i].store(buffer[i], std::memory_order_relaxed);
+                slot.sequence.store(sequence + 2, std::memory_order_release);
+                publish(version);
+                return version;
+            }
+            // 所有槽都在写入中途或受保护
+            std::this_thread::yield();
+        }
+    }
+    
+    /**
+     * 读取最新值
+     *
+     * @param value [out] 最新值，信箱为空时不修改
+     * @return 最新值的版本号，信箱为空时为 0
+     */
+    uint64_t read(t &value) const noexcept {
+        buffer_t buffer, best;
+        while (true) {
+            const auto target = latest.load(std::memory_order_acquire);
+            
+            uint64_t newest = 0;
+            for (const auto &slot : slots) {
+                const auto version = load(slot, buffer);
+                if (version > newest) {
+                    newest = version;
+                    best   = buffer;
+                }
+            }
+            // 扫描期间写者越过了开始时的最新版本，受保护的槽已经换了位置，重新扫描
+            if (newest < target) continue;
+            if (!newest) return 0;
+            
+            // 推进发布版本，之后的读者不会读到更旧的值
+            publish(newest);
+            std::memcpy(reinterpret_cast<unsigned char *>(&value), best.data(), sizeof(t));
+            return newest;
+        }
+    }
+};
+
+
+#endif //PM1_SDK_MAILBOX_T_HPP
@@ -6,60 +6,204 @@
 #define PM1_SDK_EXCEPTION_ENGINE_HPP
 
 
-#include <shared_mutex>
-#include <unordered_map>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
 
 namespace autolabor {
     /**
      * 异常驱动器
-     * 线程安全
+     * 线程安全，不分配内存
+     *
+     * 按操作序列号取模定位到定长槽环，
+     * 槽被 size 个操作之后的序列号覆盖时，旧的异常信息随之丢失，
+     * 因此无论进程运行多久，占用的内存都不变；
+     * 查询已丢失的异常信息时返回构造时指定的“已丢失”错误，不会误报为成功
+     *
+     * 每个槽由版本号保护（顺序锁）：写者独占槽，读者在写入期间让出时间片并重读，
+     * 因此不是无锁的，写者在写入中途被抢占时，同一槽的读写都要等它完成；
+     * 不同槽之间互不影响
+     *
+     * @tparam handler_t   操作序列号类型
+     * @tparam code_t      错误码类型，值初始化的错误码表示无错误
+     * @tparam size        槽数
+     * @tparam detail_size 详细信息的最大长度（含结尾 0）
      */
-    template<class handler_t = unsigned int>
+    template<class handler_t = unsigned int,
+        class code_t = unsigned int,
+        size_t size = 128,
+        size_t detail_size = 512>
     class exception_engine {
-        mutable std::shared_mutex                  mutex;
-        std::unordered_map<handler_t, std::string> map;
+        struct slot_t {
+            std::atomic<unsigned>     version{0}; // 奇数表示正在写
+            std::atomic<handler_t>    id{};
+            std::atomic<handler_t>    floor{};    // 小于此序列号的异常信息可能已被覆盖
+            std::atomic<code_t>       code{};
+            std::atomic<const char *> text{""};
+            char                      detail[detail_size]{};
+        };
+        
+        std::array<slot_t, size> slots;
+        code_t                   lost_code;
+        const char               *lost_text;
+        
+        /** 查找结果 */
+        enum class found_t { none, match, lost };
+        
+        /** 占用槽位 */
+        static unsigned acquire(slot_t &slot) {
+            auto version = slot.version.load(std::memory_order_relaxed);
+            do {
+                while (version & 1u) {
+                    std::this_thread::yield();
+                    version = slot.version.load(std::memory_order_relaxed);
+                }
+            } while (!slot.version.compare_exchange_weak(version, version + 1, std::memory_order_acquire));
+            return version + 1;
+        }
+        
+        /** 释放槽位 */
+        static void release(slot_t &slot, unsigned version) {
+            slot.version.store(version + 1, std::memory_order_release);
+        }
+        
+        /** 写入前记录将被覆盖的异常信息，调用时已占用槽位 */
+        static void evict(slot_t &slot, handler_t id) {
+            const handler_t old = slot.id;
+            if (old != id && slot.code != code_t{} && old + 1 > slot.floor)
+                slot.floor = old + 1;
+        }
+        
+        /** 读出槽位中与序列号匹配的信息 */
+        template<class f_t>
+        found_t find(handler_t id, f_t &&f) const {
+            const auto &slot = slots[id % size];
+            while (true) {
+                const auto version = slot.version.load(std::memory_order_acquire);
+                if (version & 1u) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto match  = slot.id == id && slot.code != code_t{};
+                const auto result = match ? found_t::match
+                                          : id < slot.floor ? found_t::lost
+                                                            : found_t::none;
+                if (match) f(slot);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.version.load(std::memory_order_relaxed) == version)
+                    return result;
+            }
+        }
     
     public:
         /**
-         * 增、改异常信息
-         * @param id  操作序列号
-         * @param msg 异常信息
+         * 构造器
+         * @param lost_code 查询已被覆盖的异常信息时返回的错误码
+         * @param lost_text 查询已被覆盖的异常信息时返回的信息，须为静态生存期
+         */
+        explicit exception_engine(code_t lost_code = code_t{}, const char *lost_text = "")
+            : lost_code(lost_code), lost_text(lost_text) {}
+        
+        /**
+         * 增、改异常信息（静态信息，不复制）
+         * @param id   操作序列号
+         * @param code 错误码
+         * @param text 静态生存期的异常信息，为空则移除
+         */
+        void set(handler_t id, code_t code, const char *text) noexcept {
+            if (!text || !*text) {
+                remove(id);
+                return;
+            }
+            auto &slot   = slots[id % size];
+            auto version = acquire(slot);
+            evict(slot, id);
+            slot.id        = id;
+            slot.code      = code;
+            slot.text      = text;
+            slot.detail[0] = 0;
+            release(slot, version);
+        }
+        
+        /**
+         * 增、改异常信息（复制详细信息，超长截断）
+         * @param id     操作序列号
+         * @param code   错误码
+         * @param detail 异常详细信息，为空则移除
          */
-        void set(handler_t id, const std::string &msg) {
-            std::unique_lock<decltype(mutex)> _(mutex);
-            if (msg.empty())
-                map.erase(id);
-            else
-                map[id] = msg;
+        void set_detail(handler_t id, code_t code, const char *detail) noexcept {
+            if (!detail || !*detail) {
+                remove(id);
+                return;
+            }
+            auto &slot   = slots[id % size];
+            auto version = acquire(slot);
+            const auto length = std::min(std::strlen(detail), detail_size - 1);
+            evict(slot, id);
+            slot.id   = id;
+            slot.code = code;
+            slot.text = slot.detail;
+            std::memcpy(slot.detail, detail, length);
+            slot.detail[length] = 0;
+            release(slot, version);
         }
         
         /**
          * 移除异常信息
          * @param id 操作序列号
          */
-        void remove(handler_t id) {
-            std::unique_lock<decltype(mutex)> _(mutex);
-            map.erase(id);
+        void remove(handler_t id) noexcept {
+            auto &slot   = slots[id % size];
+            auto version = acquire(slot);
+            if (slot.id == id) slot.code = code_t{};
+            release(slot, version);
         }
         
         /**
          * 清除异常信息
          */
-        void clear() {
-            std::unique_lock<decltype(mutex)> _(mutex);
-            map.clear();
+        void clear() noexcept {
+            for (auto &slot : slots) {
+                auto version = acquire(slot);
+                slot.code = code_t{};
+                release(slot, version);
+            }
+        }
+        
+        /**
+         * 根据序列号读取错误码
+         * @param id 操作序列号
+         * @return 错误码
+         */
+        code_t code(handler_t id) const noexcept {
+            code_t result{};
+            if (find(id, [&](const slot_t &slot) { result = slot.code; }) == found_t::lost)
+                result = lost_code;
+            return result;
         }
         
         /**
          * 根据序列号读取异常信息
+         * 信息在校验版本的读取过程中复制到调用线程的缓冲区，
+         * 返回的指针在本线程下次调用前有效，不受槽被覆盖的影响
          * @param id 操作序列号
          * @return 异常信息
          */
-        const char *operator[](handler_t id) const {
-            std::shared_lock<decltype(mutex)> _(mutex);
-            
-            auto ptr = map.find(id);
-            return ptr == map.end() ? "" : ptr->second.c_str();
+        const char *operator[](handler_t id) const noexcept {
+            thread_local char buffer[detail_size];
+            const auto found = find(id, [&](const slot_t &slot) {
+                // 写者可能正在改写，逐字节限长复制，版本不符时 find 会重读
+                const char *text = slot.text;
+                size_t     i     = 0;
+                for (; i < detail_size - 1 && text[i]; ++i)
+                    buffer[i] = text[i];
+                buffer[i] = 0;
+            });
+            if (found == found_t::lost) return lost_text;
+            if (found == found_t::none) buffer[0] = 0;
+            return buffer;
         }
     };
 }
@@ -6,48 +6,115 @@
 #define PM1_SDK_SAFE_SHARED_PTR_HPP
 
 
+#include <array>
+#include <atomic>
 #include <memory>
-#include <functional>
-#include <shared_mutex>
-#include "weak_shared_lock.hpp"
+#include <mutex>
+#include <thread>
+#include <stdexcept>
 
 /**
- * 共享互斥保护的资源（非阻塞）
+ * 读-复制-更新（RCU）保护的资源
  *
- * @tparam t 对象类型
+ * 读者只修改自己分片上的计数，无等待，永不因竞争而失败；
+ * 替换指针的写者等待所有可能持有旧指针的读者离开后才交出旧指针，
+ * 因此旧对象总在最后一个读者离开后析构
+ *
+ * 不能在读操作内部替换指针，否则写者会等待自己；
+ * 同一线程在读操作内部替换指针时抛出异常，不会死锁
+ *
+ * @tparam t      对象类型
+ * @tparam shards 读者计数分片数
  */
-template<class t>
+template<class t, size_t shards = 16>
 class safe_shared_ptr {
-    std::shared_ptr<t> ptr;
-    std::shared_mutex  mutex;
+    /** 独占缓存行的计数器 */
+    struct alignas(64) counter_t {
+        std::atomic<long> value{0};
+    };
+    
+    std::shared_ptr<t>                    ptr;
+    std::atomic<t *>                      raw{nullptr};
+    std::atomic<unsigned>                 epoch{0};
+    mutable std::array<counter_t, shards> readers[2];
+    std::mutex                            writer;
+    
+    /** 当前线程使用的计数分片 */
+    static size_t shard() {
+        static std::atomic<size_t> next{0};
+        static thread_local const size_t index = next++ % shards;
+        return index;
+    }
+    
+    /** 当前线程进入的读操作层数 */
+    static size_t &depth() {
+        static thread_local size_t value = 0;
+        return value;
+    }
+    
+    /** 读者区域 */
+    class read_guard {
+        std::atomic<long> &counter;
+    
+    public:
+        explicit read_guard(const safe_shared_ptr &host)
+            : counter(host.readers[host.epoch.load() & 1u][shard()].value) {
+            ++counter;
+            ++depth();
+        }
+        
+        ~read_guard() {
+            --depth();
+            --counter;
+        }
+    };
+    
+    /** 等待替换前进入的读者全部离开 */
+    void synchronize() {
+        // 两次翻转，覆盖在翻转前读取了旧纪元、翻转后才登记的读者
+        for (auto i = 0; i < 2; ++i) {
+            auto &old = readers[epoch++ & 1u];
+            for (auto &counter : old)
+                while (counter.value.load())
+                    std::this_thread::yield();
+        }
+    }
 
 public:
-    using ptr_t = decltype(ptr);
+    using ptr_t = std::shared_ptr<t>;
+    using raw_t = t *;
     
     /**
      * 替换指针
      *
      * @param new_ptr 新指针对象
-     * @return 原指针
+     * @return 原指针，已没有读者在使用
+     * @throw std::logic_error 当前线程正在读操作内部
      */
     inline ptr_t operator()(ptr_t new_ptr) {
-        std::unique_lock<decltype(mutex)> _(mutex);
+        if (depth())
+            throw std::logic_error("replacing pointer inside a read");
+        std::lock_guard<decltype(writer)> _(writer);
+        raw = new_ptr.get();
         ptr.swap(new_ptr);
+        synchronize();
         return new_ptr;
     }
     
     /**
      * 安全读取
+     *
+     * 仅在指针为空时抛出异常；
+     * 操作以模板参数传入，不经过类型擦除，也不分配内存
      */
-    template<class _t>
-    inline _t read(const std::function<_t(ptr_t)> &block) {
-        weak_shared_lock lock(mutex);
-        if (!lock)
-            throw std::logic_error("pointer is busy");
-        if (!ptr)
+    template<class f_t>
+    inline auto read(f_t &&block) const -> decltype(block(raw_t{})) {
+        read_guard _(*this);
+        const auto p = raw.load();
+        if (!p)
             throw std::logic_error("pointer is null");
         
-        return block(ptr);
+        return block(p);
     }
 };
 
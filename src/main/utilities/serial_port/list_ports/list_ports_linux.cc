@@ -23,6 +23,7 @@
  #include <unistd.h>
 
  #include "../serial.h"
+ #include "../serial_test.h"
 
 using serial::PortInfo;
 using std::istringstream;
@@ -43,6 +44,10 @@ static vector<string> get_sysfs_info(const string& device_path);
 static string read_line(const string& file);
 static string usb_sysfs_hw_string(const string& sysfs_path);
 static string format(const char* format, ...);
+static string latency_timer_path(const string& port);
+
+// 只有测试通过 serial_test.h 改为伪造的目录树
+static string sysfs_root = "/sys";
 
 vector<string>
 glob(const vector<string>& patterns)
@@ -153,7 +158,7 @@ get_sysfs_info(const string& device_path)
 
     string hardware_id;
 
-    string sys_device_path = format( "/sys/class/tty/%s/device", device_name.c_str() );
+    string sys_device_path = format( "%s/class/tty/%s/device", sysfs_root.c_str(), device_name.c_str() );
 
     if( device_name.compare(0,6,"ttyUSB") == 0 )
     {
@@ -294,6 +299,49 @@ usb_sysfs_hw_string(const string& sysfs_path)
     return format("USB VID:PID=%s:%s %s", vid.c_str(), pid.c_str(), serial_number.c_str() );
 }
 
+string
+latency_timer_path(const string& port)
+{
+    return format( "%s/class/tty/%s/device/latency_timer", sysfs_root.c_str(), basename( port ).c_str() );
+}
+
+void
+serial::set_sysfs_root(const string& root)
+{
+    sysfs_root = root;
+}
+
+int
+serial::get_latency_timer(const string& port)
+{
+    string line = read_line( latency_timer_path( port ) );
+
+    int milliseconds = -1;
+
+    if( !line.empty() )
+        istringstream( line ) >> milliseconds;
+
+    return milliseconds;
+}
+
+bool
+serial::set_latency_timer(const string& port, int milliseconds)
+{
+    string path = latency_timer_path( port );
+
+    if( !path_exists( path ) )
+        return false;
+
+    std::ofstream ofs(path.c_str(), std::ofstream::out);
+
+    if( !ofs )
+        return false;
+
+    ofs << milliseconds << endl;
+
+    return !ofs.fail() && get_latency_timer( port ) == milliseconds;
+}
+
 vector<PortInfo>
 serial::list_ports()
 {
@@ -28,6 +28,11 @@ std::string utf8_encode(const std::wstring &wstr) {
     return strTo;
 }
 
+// Windows 的延迟定时器在驱动注册表项中，不在运行时调整
+int serial::get_latency_timer(const std::string &) { return -1; }
+
+bool serial::set_latency_timer(const std::string &, int) { return false; }
+
 std::vector<serial::PortInfo>
 serial::list_ports() {
     std::vector<PortInfo> devices_found;
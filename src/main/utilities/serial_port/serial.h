@@ -21,6 +21,23 @@ namespace serial {
     };
     
     std::vector<PortInfo> list_ports();
+    
+    /**
+     * 读取 USB 转串口适配器的接收延迟定时器
+     *
+     * @param port 串口名字
+     * @return 定时器（毫秒），适配器不支持时返回 -1
+     */
+    int get_latency_timer(const std::string &port);
+    
+    /**
+     * 设置 USB 转串口适配器的接收延迟定时器
+     *
+     * @param port         串口名字
+     * @param milliseconds 定时器（毫秒）
+     * @return 是否成功，适配器不支持或没有写权限时失败
+     */
+    bool set_latency_timer(const std::string &port, int milliseconds);
 } // namespace serial
 
 
@@ -15,13 +15,20 @@ class serial_port final {
 public:
     /**
      * 构造器
+     *
+     * 波特率不在标准值之列时按任意波特率设置（Linux 使用 termios2）
+     *
+     * @param frame_size 低延迟模式下一次读取凑齐的字节数，0 表示不启用；
+     *                   启用时请求驱动关闭接收缓冲延迟，
+     *                   读操作在凑齐一帧或字节间隔超过 0.1 秒时返回。仅 Linux 有效
      */
     explicit serial_port(const std::string &name,
                          unsigned int baud_rate = 9600,
                          uint8_t check_period = 3,
                          uint8_t wait_period = 1,
                          size_t in_buffer_size = 0x100,
-                         size_t out_buffer_size = 0x100);
+                         size_t out_buffer_size = 0x100,
+                         uint8_t frame_size = 0);
     
     /**
      * 析构器
@@ -43,6 +50,30 @@ public:
      * 中断正在阻塞的读操作
      */
     void break_read() const noexcept;
+    
+    /**
+     * 以原有设置重新打开串口
+     *
+     * 句柄原地替换，不影响其他线程正在进行的发送
+     *
+     * @param name 串口名字，为空则使用原来的名字
+     */
+    void reopen(const std::string &name = "");
+    
+    /**
+     * 当前打开的串口名字
+     */
+    std::string name() const;
+    
+    /**
+     * 累计发送的字节数
+     */
+    size_t bytes_sent() const;
+    
+    /**
+     * 累计接收的字节数
+     */
+    size_t bytes_received() const;
 
 private:
     #if   defined(_MSC_VER)
@@ -57,6 +88,21 @@ private:
     std::atomic<handler_t> handle;
     
     mutable std::mutex read_mutex;
+    
+    /** 打开设置，用于重新打开 */
+    std::string  _name;
+    unsigned int baud_rate;
+    uint8_t      check_period,
+                 wait_period;
+    size_t       in_buffer_size,
+                 out_buffer_size;
+    uint8_t      frame_size;
+    
+    mutable std::mutex name_mutex;
+    
+    /** 流量统计 */
+    std::atomic<size_t> sent{0},
+                        received{0};
 };
 
 
@@ -0,0 +1,27 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifdef __linux__
+
+#include <sys/ioctl.h>
+#include <asm/termbits.h>
+
+/**
+ * 以 termios2 设置任意波特率
+ *
+ * @return 是否成功，失败时 errno 有效
+ */
+bool set_custom_baud_rate(int handle, unsigned int baud_rate) {
+    termios2 options{};
+    if (ioctl(handle, TCGETS2, &options)) return false;
+    options.c_cflag &= ~CBAUD;
+    options.c_cflag |= BOTHER;
+    options.c_cflag &= ~(CBAUD << IBSHIFT);
+    options.c_cflag |= BOTHER << IBSHIFT;
+    options.c_ispeed = baud_rate;
+    options.c_ospeed = baud_rate;
+    return ioctl(handle, TCSETS2, &options) == 0;
+}
+
+#endif
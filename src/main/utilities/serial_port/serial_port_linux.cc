@@ -12,6 +12,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <termios.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
 #include <cstring>
 
 #include "macros.h"
@@ -19,42 +22,96 @@
 
 #define TRY(OPERATION) if(!OPERATION) THROW(#OPERATION, std::strerror(errno))
 
+/** 标准波特率常量，非标准值返回 -1 */
 inline int trans_baud(int number);
 
+/** 设置任意波特率，定义在 serial_port_baud_linux.cc（termios2 与 termios.h 不能共存） */
+bool set_custom_baud_rate(int handle, unsigned int baud_rate);
+
+/** 读操作检查中断的间隔（毫秒） */
+constexpr int break_check_ms = 10;
+
 enum class read_state_t {
     check, read, wait
 };
 
-serial_port::serial_port(
-    const std::string &name,
-    unsigned int baud_rate,
-    uint8_t check_period,
-    uint8_t, size_t, size_t
-) : break_flag(false) {
-    
-    handle = open(name.c_str(), O_RDWR | O_NOCTTY);
+/** 打开并设置串口 */
+static int open_port(const std::string &name,
+                     unsigned int baud_rate,
+                     uint8_t check_period,
+                     uint8_t frame_size) {
+    int handle = open(name.c_str(), O_RDWR | O_NOCTTY);
     
     if (handle == -1)
         THROW("open(...)", std::strerror(errno));
     
-    // 设置端口设定
-    termios options{};
-    TRY(!tcgetattr(handle, &options));
-    cfsetispeed(&options, trans_baud(baud_rate));
-    cfsetospeed(&options, trans_baud(baud_rate));
-    
-    // 8N1, no flow control
-    options.c_cflag &= ~(PARENB | CSTOPB | CSIZE | CRTSCTS);
-    options.c_cflag |= CREAD | CLOCAL; // turn on READ & ignore ctrl lines
-    options.c_cflag |= CS8;
-    
-    options.c_lflag =
-    options.c_iflag =
-    options.c_oflag = 0;
-    options.c_cc[VMIN]  = 0;
-    options.c_cc[VTIME] = check_period;
-    
-    TRY(!tcsetattr(handle, TCSANOW, &options));
+    try {
+        // 设置端口设定
+        termios options{};
+        TRY(!tcgetattr(handle, &options));
+        const auto standard = trans_baud(baud_rate);
+        if (standard >= 0) {
+            cfsetispeed(&options, standard);
+            cfsetospeed(&options, standard);
+        }
+        
+        // 8N1, no flow control
+        options.c_cflag &= ~(PARENB | CSTOPB | CSIZE | CRTSCTS);
+        options.c_cflag |= CREAD | CLOCAL; // turn on READ & ignore ctrl lines
+        options.c_cflag |= CS8;
+        
+        options.c_lflag =
+        options.c_iflag =
+        options.c_oflag = 0;
+        if (frame_size) {
+            // 凑齐一帧再唤醒读线程，字节间隔超过 0.1 秒则提前返回
+            options.c_cc[VMIN]  = frame_size;
+            options.c_cc[VTIME] = 1;
+        } else {
+            options.c_cc[VMIN]  = 0;
+            options.c_cc[VTIME] = check_period;
+        }
+        
+        TRY(!tcsetattr(handle, TCSANOW, &options));
+        if (standard < 0 && !set_custom_baud_rate(handle, baud_rate))
+            THROW("set baud rate", std::strerror(errno));
+        
+        // 关闭驱动的接收缓冲延迟，伪终端等不支持的设备忽略
+        serial_struct serial{};
+        if (frame_size && ioctl(handle, TIOCGSERIAL, &serial) == 0) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            ioctl(handle, TIOCSSERIAL, &serial);
+        }
+    } catch (...) {
+        close(handle);
+        throw;
+    }
+    return handle;
+}
+
+/** 检查设备是否已挂断 */
+static bool hung_up(int handle) {
+    pollfd target{handle, POLLIN, 0};
+    return poll(&target, 1, 0) > 0 && (target.revents & (POLLHUP | POLLERR | POLLNVAL));
+}
+
+serial_port::serial_port(
+    const std::string &name,
+    unsigned int baud_rate,
+    uint8_t check_period,
+    uint8_t wait_period,
+    size_t in_buffer_size,
+    size_t out_buffer_size,
+    uint8_t frame_size
+) : break_flag(false),
+    _name(name),
+    baud_rate(baud_rate),
+    check_period(check_period),
+    wait_period(wait_period),
+    in_buffer_size(in_buffer_size),
+    out_buffer_size(out_buffer_size),
+    frame_size(frame_size) {
+    handle = open_port(name, baud_rate, check_period, frame_size);
 }
 
 serial_port::~serial_port() {
@@ -65,7 +122,10 @@ serial_port::~serial_port() {
 }
 
 void serial_port::send(const uint8_t *buffer, size_t size) noexcept {
-    if (size > 0) TRY(size == write(handle, buffer, size));
+    // 设备断开时写入失败，错误由读操作报告
+    if (size == 0) return;
+    const auto actual = write(handle, buffer, size);
+    if (actual > 0) sent += actual;
 }
 
 size_t serial_port::read(uint8_t *buffer, size_t size) {
@@ -73,8 +133,28 @@ size_t serial_port::read(uint8_t *buffer, size_t size) {
     if (!lock) return 0;
     
     while (true) {
+        // 先分段等待可读，以便及时响应中断和挂断；
+        // 否则 read 要到超时（普通模式）或收到首字节（低延迟模式）才返回
+        pollfd target{handle, POLLIN, 0};
+        const auto ready = poll(&target, 1, break_check_ms);
+        if (break_flag) return 0;
+        if (ready < 0 && errno != EINTR)
+            THROW("poll(...)", std::strerror(errno));
+        if (ready <= 0) continue;
+        if (!(target.revents & POLLIN))
+            THROW("read(...)", "device hung up");
+        
         auto temp = ::read(handle, buffer, size);
-        if (temp > 0 || break_flag) return temp;
+        if (temp > 0) {
+            received += temp;
+            return temp;
+        }
+        if (break_flag) return 0;
+        if (temp < 0 && errno != EINTR && errno != EAGAIN)
+            THROW("read(...)", std::strerror(errno));
+        // 超时和挂断都读到 0 字节，需要区分
+        if (temp == 0 && hung_up(handle))
+            THROW("read(...)", "device hung up");
     }
 }
 
@@ -86,6 +166,32 @@ void serial_port::break_read() const noexcept {
     break_flag = false;
 }
 
+void serial_port::reopen(const std::string &name) {
+    std::lock_guard<decltype(name_mutex)> lock(name_mutex);
+    
+    const auto target = name.empty() ? _name : name;
+    const auto temp   = open_port(target, baud_rate, check_period, frame_size);
+    // 原地替换文件描述符，其他线程持有的句柄值保持有效
+    const auto result = dup2(temp, handle);
+    close(temp);
+    if (result == -1)
+        THROW("dup2(...)", std::strerror(errno));
+    _name = target;
+}
+
+std::string serial_port::name() const {
+    std::lock_guard<decltype(name_mutex)> lock(name_mutex);
+    return _name;
+}
+
+size_t serial_port::bytes_sent() const {
+    return sent;
+}
+
+size_t serial_port::bytes_received() const {
+    return received;
+}
+
 int trans_baud(int number) {
     switch (number) {
         case 0:
@@ -151,7 +257,7 @@ int trans_baud(int number) {
         case 4000000:
             return B4000000;
         default:
-            THROW("set baud rate", "unsupported value");
+            return -1;
     }
 }
 
@@ -16,41 +16,66 @@
 
 #define TRY(OPERATION) if(!OPERATION) THROW(#OPERATION, GetLastError())
 
+/** 打开并设置串口 */
+static void *open_port(const std::string &name,
+                       unsigned int baud_rate,
+                       uint8_t check_period,
+                       uint8_t wait_period,
+                       size_t in_buffer_size,
+                       size_t out_buffer_size) {
+    auto temp   = std::string(R"(\\.\)") + name;
+    auto handle = CreateFileA(temp.c_str(),                                // 串口名，`COM9` 之后需要前缀
+                              GENERIC_READ | GENERIC_WRITE, // 读和写
+                              0,                              // 独占模式
+                              nullptr,                    // 子进程无权限
+                              OPEN_EXISTING,                               // 打开设备
+                              FILE_FLAG_OVERLAPPED,
+                              nullptr);
+    
+    if (handle == INVALID_HANDLE_VALUE)
+        THROW("CreateFileA(...)", GetLastError());
+    
+    try {
+        // 设置端口设定
+        DCB dcb;
+        TRY(GetCommState(handle, &dcb));
+        dcb.BaudRate = baud_rate;
+        dcb.ByteSize = 8;
+        TRY(SetCommState(handle, &dcb));
+        
+        // 设置超时时间
+        COMMTIMEOUTS timeouts{check_period, wait_period, 0, 10, 0};
+        TRY(SetCommTimeouts(handle, &timeouts));
+        
+        // 设置缓冲区容量
+        TRY(SetupComm(handle, in_buffer_size, out_buffer_size));
+        
+        // 订阅事件
+        TRY(SetCommMask(handle, EV_RXCHAR));
+    } catch (...) {
+        CloseHandle(handle);
+        throw;
+    }
+    return handle;
+}
+
 serial_port::serial_port(const std::string &name,
                          unsigned int baud_rate,
                          uint8_t check_period,
                          uint8_t wait_period,
                          size_t in_buffer_size,
-                         size_t out_buffer_size) {
-    
-    auto temp = std::string(R"(\\.\)") + name;
-    handle = CreateFileA(temp.c_str(),                                // 串口名，`COM9` 之后需要前缀
-                         GENERIC_READ | GENERIC_WRITE, // 读和写
-                         0,                              // 独占模式
-                         nullptr,                    // 子进程无权限
-                         OPEN_EXISTING,                               // 打开设备
-                         FILE_FLAG_OVERLAPPED,
-                         nullptr);
-    
-    if (handle == INVALID_HANDLE_VALUE)
-        THROW("CreateFileA(...)", GetLastError());
-    
-    // 设置端口设定
-    DCB dcb;
-    TRY(GetCommState(handle, &dcb));
-    dcb.BaudRate = baud_rate;
-    dcb.ByteSize = 8;
-    TRY(SetCommState(handle, &dcb));
-    
-    // 设置超时时间
-    COMMTIMEOUTS timeouts{check_period, wait_period, 0, 10, 0};
-    TRY(SetCommTimeouts(handle, &timeouts));
-    
-    // 设置缓冲区容量
-    TRY(SetupComm(handle, in_buffer_size, out_buffer_size));
-    
-    // 订阅事件
-    TRY(SetCommMask(handle, EV_RXCHAR));
+                         size_t out_buffer_size,
+                         uint8_t frame_size)
+    : _name(name),
+      baud_rate(baud_rate),
+      check_period(check_period),
+      wait_period(wait_period),
+      in_buffer_size(in_buffer_size),
+      out_buffer_size(out_buffer_size),
+      frame_size(frame_size) {
+    handle = open_port(name, baud_rate,
+                       check_period, wait_period,
+                       in_buffer_size, out_buffer_size);
 }
 
 serial_port::~serial_port() noexcept {
@@ -88,7 +113,8 @@ void serial_port::send(const uint8_t *buffer, size_t size) noexcept {
         handle.load()
     };
     overlapped->hEvent = ptr;
-    WriteFileEx(handle, ptr->buffer_ptr.data(), size, overlapped, &callback);
+    if (WriteFileEx(handle, ptr->buffer_ptr.data(), size, overlapped, &callback))
+        sent += size;
     SleepEx(INFINITE, true);
 }
 
@@ -118,6 +144,7 @@ size_t serial_port::read(uint8_t *buffer, size_t size) {
         case ERROR_IO_PENDING: {
             DWORD actual = 0;
             GetOverlappedResult(handle, &overlapped, &actual, true);
+            received += actual;
             return actual;
         }
         default:
@@ -136,4 +163,33 @@ void serial_port::break_read() const noexcept {
     }
 }
 
+void serial_port::reopen(const std::string &name) {
+    std::lock_guard<decltype(name_mutex)> lock(name_mutex);
+    
+    const auto target = name.empty() ? _name : name;
+    const auto temp   = open_port(target, baud_rate,
+                                  check_period, wait_period,
+                                  in_buffer_size, out_buffer_size);
+    // 正在进行的重叠发送会在旧句柄上失败，由完成回调清理
+    const auto old    = handle.exchange(temp);
+    if (old) {
+        PurgeComm(old, PURGE_RXABORT | PURGE_RXCLEAR | PURGE_TXABORT | PURGE_TXCLEAR);
+        CloseHandle(old);
+    }
+    _name = target;
+}
+
+std::string serial_port::name() const {
+    std::lock_guard<decltype(name_mutex)> lock(name_mutex);
+    return _name;
+}
+
+size_t serial_port::bytes_sent() const {
+    return sent;
+}
+
+size_t serial_port::bytes_received() const {
+    return received;
+}
+
 #endif
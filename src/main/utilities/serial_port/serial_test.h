@@ -0,0 +1,23 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef SERIAL_TEST_H
+#define SERIAL_TEST_H
+
+
+#include <string>
+
+/**
+ * 仅供测试使用的串口工具接口，不随 SDK 发布
+ */
+namespace serial {
+    /**
+     * 设置 sysfs 挂载点，默认为 "/sys"
+     * 测试时指向伪造的目录树
+     */
+    void set_sysfs_root(const std::string &root);
+} // namespace serial
+
+
+#endif
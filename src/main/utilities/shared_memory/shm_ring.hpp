@@ -0,0 +1,238 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_SHM_RING_HPP
+#define PM1_SDK_SHM_RING_HPP
+
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace autolabor {
+    /**
+     * 共享内存环形缓冲区的布局
+     *
+     * 单写者，多读者；每个槽有独立的版本号（序列锁），
+     * 写第 n 条记录时槽版本先置为 2n - 1，写完置为 2n，
+     * 读者据此判断记录是否完整、是否已被覆盖，不需要任何锁
+     *
+     * @tparam t 记录类型，必须可平凡复制
+     */
+    template<class t>
+    struct shm_ring_layout {
+        static_assert(std::is_trivially_copyable<t>::value, "record must be trivially copyable");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "64-bit atomics must be lock-free");
+        
+        constexpr static uint32_t magic = 0x314d5050; // "PPM1"
+        
+        struct header_t {
+            uint32_t              magic,
+                                  record_size,
+                                  capacity;
+            std::atomic<uint64_t> head; // 已写入的记录总数
+        };
+        
+        struct alignas(64) slot_t {
+            std::atomic<uint64_t> version;
+            t                     record;
+        };
+        
+        static size_t size_of(uint32_t capacity) {
+            return sizeof(header_t) + sizeof(slot_t) * capacity;
+        }
+        
+        static slot_t *slots(header_t *header) {
+            return reinterpret_cast<slot_t *>(header + 1);
+        }
+        
+        static const slot_t *slots(const header_t *header) {
+            return reinterpret_cast<const slot_t *>(header + 1);
+        }
+    };
+    
+    /**
+     * 共享内存环形缓冲区写者
+     *
+     * 写入不等待任何读者
+     */
+    template<class t>
+    class shm_ring_writer {
+        using layout_t = shm_ring_layout<t>;
+        
+        std::string                  name;
+        size_t                       size;
+        typename layout_t::header_t *header;
+        typename layout_t::slot_t   *slots;
+    
+    public:
+        /**
+         * 创建共享内存，同名的旧共享内存先被移除
+         *
+         * @param name     共享内存名字，如 "/pm1_telemetry"
+         * @param capacity 槽数
+         */
+        shm_ring_writer(const std::string &name, uint32_t capacity)
+            : name(name), size(layout_t::size_of(capacity)) {
+            if (capacity == 0)
+                throw std::invalid_argument("ring capacity must be positive");
+            shm_unlink(name.c_str());
+            const auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd < 0)
+                throw std::runtime_error("failed to create shared memory " + name + ": " + std::strerror(errno));
+            if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+                close(fd);
+                shm_unlink(name.c_str());
+                throw std::runtime_error("failed to resize shared memory " + name);
+            }
+            const auto memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED) {
+                shm_unlink(name.c_str());
+                throw std::runtime_error("failed to map shared memory " + name);
+            }
+            // ftruncate 保证内容为 0，原子量的初值即为 0
+            header = static_cast<typename layout_t::header_t *>(memory);
+            slots  = layout_t::slots(header);
+            header->record_size = sizeof(t);
+            header->capacity    = capacity;
+            std::atomic_thread_fence(std::memory_order_release);
+            header->magic = layout_t::magic;
+        }
+        
+        ~shm_ring_writer() {
+            munmap(header, size);
+            shm_unlink(name.c_str());
+        }
+        
+        shm_ring_writer(const shm_ring_writer &) = delete;
+        
+        shm_ring_writer &operator=(const shm_ring_writer &) = delete;
+        
+        /** 写入一条记录 */
+        void write(const t &record) noexcept {
+            const auto n    = header->head.load(std::memory_order_relaxed) + 1;
+            auto       &slot = slots[(n - 1) % header->capacity];
+            slot.version.store(2 * n - 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&slot.record, &record, sizeof(t));
+            slot.version.store(2 * n, std::memory_order_release);
+            header->head.store(n, std::memory_order_release);
+        }
+    };
+    
+    /**
+     * 共享内存环形缓冲区读者
+     *
+     * 只读映射，无锁，永不阻塞写者；
+     * 读得太慢、记录已被覆盖时跳到仍然有效的最旧记录，并报告丢失的条数
+     */
+    template<class t>
+    class shm_ring_reader {
+        using layout_t = shm_ring_layout<t>;
+        
+        size_t                             size;
+        const typename layout_t::header_t *header;
+        const typename layout_t::slot_t    *slots;
+        uint64_t                           next;
+    
+    public:
+        /** 读取结果 */
+        enum class result_t { record, empty, overrun };
+        
+        /**
+         * 连接到共享内存
+         *
+         * @param name 共享内存名字
+         */
+        explicit shm_ring_reader(const std::string &name) {
+            const auto fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                throw std::runtime_error("failed to open shared memory " + name + ": " + std::strerror(errno));
+            struct stat info{};
+            if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(typename layout_t::header_t)) {
+                close(fd);
+                throw std::runtime_error("shared memory " + name + " is not initialized");
+            }
+            size = static_cast<size_t>(info.st_size);
+            const auto memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED)
+                throw std::runtime_error("failed to map shared memory " + name);
+            header = static_cast<const typename layout_t::header_t *>(memory);
+            if (header->magic != layout_t::magic
+                || header->record_size != sizeof(t)
+                || layout_t::size_of(header->capacity) > size) {
+                munmap(const_cast<void *>(memory), size);
+                throw std::runtime_error("shared memory " + name + " has an incompatible layout");
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            slots = layout_t::slots(header);
+            next  = header->head.load(std::memory_order_acquire) + 1;
+        }
+        
+        ~shm_ring_reader() {
+            munmap(const_cast<typename layout_t::header_t *>(header), size);
+        }
+        
+        shm_ring_reader(const shm_ring_reader &) = delete;
+        
+        shm_ring_reader &operator=(const shm_ring_reader &) = delete;
+        
+        /** 写者已写入的记录总数 */
+        uint64_t head() const noexcept {
+            return header->head.load(std::memory_order_acquire);
+        }
+        
+        /**
+         * 读取下一条记录
+         *
+         * @param record 记录
+         * @param lost   发生覆盖时丢失的记录数
+         * @return record：读到记录；empty：没有新记录；overrun：记录已被覆盖，已跳过
+         */
+        result_t read(t &record, uint64_t &lost) noexcept {
+            const auto capacity = header->capacity;
+            while (true) {
+                const auto &slot   = slots[(next - 1) % capacity];
+                const auto expect  = 2 * next;
+                const auto version = slot.version.load(std::memory_order_acquire);
+                if (version == expect) {
+                    std::memcpy(&record, &slot.record, sizeof(t));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.version.load(std::memory_order_relaxed) == expect) {
+                        ++next;
+                        return result_t::record;
+                    }
+                } else if (version < expect) {
+                    // 尚未写入或正在写入
+                    return result_t::empty;
+                }
+                // 已被覆盖，跳到仍然有效的最旧记录
+                const auto head   = header->head.load(std::memory_order_acquire);
+                const auto oldest = head > capacity ? head - capacity + 1 : 1;
+                if (oldest > next) {
+                    lost = oldest - next;
+                    next = oldest;
+                    return result_t::overrun;
+                }
+            }
+        }
+    };
+}
+
+#endif // defined(__linux__)
+
+
+#endif //PM1_SDK_SHM_RING_HPP
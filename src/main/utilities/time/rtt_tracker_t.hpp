@@ -0,0 +1,150 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#ifndef PM1_SDK_RTT_TRACKER_T_HPP
+#define PM1_SDK_RTT_TRACKER_T_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include "time_extensions.h"
+
+namespace autolabor {
+    /** 往返时间统计 */
+    struct rtt_stats_t {
+        unsigned long long samples, // 累计配对成功的应答数
+                           lost;    // 累计未得到应答的询问数
+        double             min,     // 统计窗口内的最短往返时间（秒）
+                           avg,     // 统计窗口内的平均往返时间（秒）
+                           p99;     // 统计窗口内的 99% 分位往返时间（秒）
+    };
+    
+    /**
+     * 往返时间跟踪器
+     * 线程安全
+     *
+     * 每类询问的发送时刻分别排队，应答与同类中最早的未应答询问配对；
+     * 配对时已超过 expire 的询问记为丢失，避免一次丢帧使之后的配对全部错位
+     *
+     * @tparam queries 询问种类数
+     * @tparam window  统计窗口的样本数
+     */
+    template<size_t queries, size_t window = 128>
+    class rtt_tracker_t {
+        using time_t = decltype(now());
+        
+        /** 每类询问最多同时等待的应答数 */
+        constexpr static size_t depth = 4;
+        
+        struct pending_t {
+            std::array<time_t, depth> time;
+            size_t                    begin = 0, size = 0;
+            
+            const time_t &front() const { return time[begin]; }
+            
+            void pop() {
+                begin = (begin + 1) % depth;
+                --size;
+            }
+        };
+        
+        mutable std::mutex             mutex;
+        std::array<pending_t, queries> pending{};
+        std::array<double, window>     samples{};
+        unsigned long long             total = 0, lost = 0;
+        seconds_floating               expire;
+        
+        /** 缓存的中位数和 99% 分位值，供高频路径无锁读取 */
+        std::atomic<double> cached_p50{0},
+                            cached_p99{0};
+        
+        /** 丢弃已过期的询问 */
+        void drop_expired(pending_t &queue, time_t time) {
+            while (queue.size && time - queue.front() > expire) {
+                queue.pop();
+                ++lost;
+            }
+        }
+        
+        /** 窗口内的样本，按升序排列 */
+        size_t sorted(std::array<double, window> &buffer) const {
+            const auto size = static_cast<size_t>(std::min<unsigned long long>(total, window));
+            std::copy(samples.begin(), samples.begin() + size, buffer.begin());
+            std::sort(buffer.begin(), buffer.begin() + size);
+            return size;
+        }
+    
+    public:
+        /**
+         * 构造器
+         * @param expire 询问得不到应答的最长等待时间
+         */
+        explicit rtt_tracker_t(seconds_floating expire = std::chrono::seconds(1))
+            : expire(expire) {}
+        
+        /** 记录询问的发送时刻 */
+        void sent(size_t query, time_t time) {
+            std::lock_guard<std::mutex> _(mutex);
+            auto                        &queue = pending[query];
+            drop_expired(queue, time);
+            if (queue.size == depth) {
+                queue.pop();
+                ++lost;
+            }
+            queue.time[(queue.begin + queue.size++) % depth] = time;
+        }
+        
+        /**
+         * 记录应答的到达时刻
+         * @return 是否配对成功，没有等待中的询问时失败
+         */
+        bool received(size_t query, time_t time) {
+            std::lock_guard<std::mutex> _(mutex);
+            auto                        &queue = pending[query];
+            drop_expired(queue, time);
+            if (!queue.size) return false;
+            
+            samples[total++ % window] = duration_seconds(time - queue.front());
+            queue.pop();
+            
+            // 样本较少时逐个刷新缓存，之后每 16 个样本刷新一次
+            if (total < 16 || total % 16 == 0) {
+                std::array<double, window> buffer;
+                const auto                 size = sorted(buffer);
+                cached_p50 = buffer[(size - 1) / 2];
+                cached_p99 = buffer[(size - 1) * 99 / 100];
+            }
+            return true;
+        }
+        
+        /** 最近一次刷新的往返时间中位数（秒），没有样本时为 0 */
+        double p50() const { return cached_p50; }
+        
+        /** 最近一次刷新的 99% 分位往返时间（秒），没有样本时为 0 */
+        double p99() const { return cached_p99; }
+        
+        /** 统计 */
+        rtt_stats_t stats() const {
+            std::lock_guard<std::mutex> _(mutex);
+            
+            rtt_stats_t                result{total, lost, 0, 0, 0};
+            std::array<double, window> buffer;
+            const auto                 size = sorted(buffer);
+            if (size) {
+                double sum = 0;
+                for (size_t i = 0; i < size; ++i) sum += buffer[i];
+                result.min = buffer[0];
+                result.avg = sum / size;
+                result.p99 = buffer[(size - 1) * 99 / 100];
+            }
+            return result;
+        }
+    };
+}
+
+
+#endif //PM1_SDK_RTT_TRACKER_T_HPP
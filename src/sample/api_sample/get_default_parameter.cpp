@@ -16,5 +16,6 @@ int main() {
               << "max_v          : " << get_default_parameter(parameter_id::max_v) << std::endl
               << "max_w          : " << get_default_parameter(parameter_id::max_w) << std::endl
               << "optimize_width : " << get_default_parameter(parameter_id::optimize_width) << std::endl
-              << "acceleration   : " << get_default_parameter(parameter_id::acceleration) << std::endl;
+              << "acceleration   : " << get_default_parameter(parameter_id::acceleration) << std::endl
+              << "jerk           : " << get_default_parameter(parameter_id::jerk) << std::endl;
 }
@@ -12,8 +12,13 @@ int main() {
     
     if (!initialize()) return 1;
     auto time = std::chrono::steady_clock::now();
+    auto seq  = 0ull;
     while (std::chrono::steady_clock::now() - time < 3s) {
         drive(0.2, 0);
-        std::cout << get_odometry().value.x << std::endl;
+        // 阻塞到下一次里程计更新，不空转也不漏数据
+        auto odometry = wait_odometry(seq, 0.1);
+        if (!odometry) continue;
+        seq = odometry.value.seq;
+        std::cout << odometry.value.x << std::endl;
     }
 }
@@ -17,5 +17,6 @@ int main() {
               << "max_v          : " << get_parameter(parameter_id::max_v).value << std::endl
               << "max_w          : " << get_parameter(parameter_id::max_w).value << std::endl
               << "optimize_width : " << get_parameter(parameter_id::optimize_width).value << std::endl
-              << "acceleration   : " << get_parameter(parameter_id::acceleration).value << std::endl;
+              << "acceleration   : " << get_parameter(parameter_id::acceleration).value << std::endl
+              << "jerk           : " << get_parameter(parameter_id::jerk).value << std::endl;
 }
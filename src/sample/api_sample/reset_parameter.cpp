@@ -17,6 +17,7 @@ int main() {
     reset_parameter(parameter_id::max_w);
     reset_parameter(parameter_id::optimize_width);
     reset_parameter(parameter_id::acceleration);
+    reset_parameter(parameter_id::jerk);
     reset_parameter(parameter_id::max_v);
     reset_parameter(parameter_id::max_w);
 }
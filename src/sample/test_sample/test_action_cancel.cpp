@@ -0,0 +1,220 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <pm1_sdk_native.h>
+
+#include <internal/can/parser_t.hpp>
+#include <internal/can_define.h>
+#include <utilities/serial_parser/parse_engine.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace autolabor::pm1;
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * 伪终端上的最小底盘
+ *
+ * 应答状态和位置查询，记录最近一次收到左轮零速度帧的时刻和非零速度帧的数量
+ */
+class chassis_emulator {
+    int               master;
+    std::atomic<bool> running{true};
+    std::mutex        io;
+    std::thread       thread;
+    
+    template<class t>
+    void send(const t &msg) {
+        std::lock_guard<decltype(io)> _(io);
+        write(master, &msg, sizeof(t));
+    }
+    
+    void on(const autolabor::can::parser_t::result_t &result) {
+        using namespace autolabor::can;
+        using type_t = parser_t::result_type_t;
+        
+        if (result.type == type_t::signal) {
+            const auto &msg = result.signal;
+            if (unit<>::state_tx::match(msg)) {
+                send(pack_value<unit<ecu<0>>::state_rx, uint8_t>(1));
+                send(pack_value<unit<ecu<1>>::state_rx, uint8_t>(1));
+                send(pack_value<unit<tcu<0>>::state_rx, uint8_t>(1));
+                send(pack_value<unit<vcu<0>>::state_rx, uint8_t>(1));
+            } else if (ecu<>::current_position_tx::match(msg)) {
+                send(pack_value<ecu<0>::current_position_rx, int>(0));
+                send(pack_value<ecu<1>::current_position_rx, int>(0));
+            } else if (tcu<0>::current_position_tx::match(msg)) {
+                send(pack_value<tcu<0>::current_position_rx, short>(0));
+            } else if (vcu<>::battery_percent_tx::match(msg)) {
+                send(pack_value<vcu<0>::battery_percent_rx, uint8_t>(100));
+            }
+        } else if (result.type == type_t::message) {
+            const auto &msg = result.message;
+            if (ecu<0>::target_speed::match(msg)) {
+                const auto value = get_data_value<int>(msg);
+                if (value == 0 && moving.exchange(false))
+                    stopped = clock_type::now();
+                else if (value != 0) {
+                    moving = true;
+                    ++moving_frames;
+                }
+            }
+        }
+    }
+
+public:
+    std::string                         name;
+    std::atomic<bool>                   moving{false};
+    std::atomic<unsigned>               moving_frames{0};
+    std::atomic<clock_type::time_point> stopped{};
+    
+    chassis_emulator() {
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        grantpt(master);
+        unlockpt(master);
+        name = ptsname(master);
+        
+        termios options{};
+        const auto slave = open(name.c_str(), O_RDWR | O_NOCTTY);
+        tcgetattr(slave, &options);
+        cfmakeraw(&options);
+        tcsetattr(slave, TCSANOW, &options);
+        close(slave);
+        
+        thread = std::thread([this] {
+            autolabor::parse_engine_t<autolabor::can::parser_t> engine;
+            uint8_t buffer[256];
+            while (running) {
+                pollfd target{master, POLLIN, 0};
+                if (::poll(&target, 1, 20) <= 0) continue;
+                const auto size = read(master, buffer, sizeof buffer);
+                if (size > 0)
+                    engine(buffer, buffer + size, [this](const autolabor::can::parser_t::result_t &r) { on(r); });
+            }
+        });
+    }
+    
+    ~chassis_emulator() {
+        running = false;
+        thread.join();
+        close(master);
+    }
+};
+
+/**
+ * 动作取消与暂停延迟测试
+ *
+ * 在伪终端模拟的底盘上执行定时动作，起步后分别取消和暂停，
+ * 统计调用开始到底盘收到零速度帧的延迟。
+ * 尾部延迟取决于调度器，在繁忙的构建机上不稳定，因此只用中位数判定：
+ * 中位数超过 5 毫秒，或任何一轮 1 秒内没有停车时以非零值退出；
+ * 最后在路径跟随中暂停，停车后不应再收到非零速度帧，恢复后应接着跟随
+ */
+int main() {
+    using namespace std::chrono;
+    
+    constexpr static auto rounds = 100;
+    constexpr static auto bound  = microseconds(5000);
+    
+    chassis_emulator emulator;
+    double           progress;
+    auto             id = native::initialize(emulator.name.c_str(), progress);
+    if (native::get_error_code(id)) {
+        std::cerr << native::get_error_info(id) << std::endl;
+        return 1;
+    }
+    native::set_enabled(true);
+    
+    auto failed = false;
+    for (const auto pause : {false, true}) {
+        std::vector<microseconds> latency;
+        for (auto i = 0; i < rounds; ++i) {
+            std::thread action([] {
+                double p;
+                native::drive_timing(0.2, 0, 10, p);
+            });
+            while (!emulator.moving)
+                std::this_thread::sleep_for(milliseconds(1));
+            std::this_thread::sleep_for(milliseconds(10 + i % 7 * 3));
+            
+            const auto begin = clock_type::now();
+            if (pause)
+                native::set_paused(true);
+            else
+                native::cancel_action();
+            while (emulator.moving && clock_type::now() - begin < seconds(1))
+                std::this_thread::yield();
+            if (emulator.moving) {
+                std::cout << (pause ? "pause " : "cancel") << " did not stop the chassis" << std::endl;
+                failed = true;
+            } else {
+                latency.push_back(duration_cast<microseconds>(emulator.stopped.load() - begin));
+            }
+            
+            if (pause) {
+                native::set_paused(false);
+                native::cancel_action();
+            }
+            action.join();
+        }
+        if (latency.empty()) continue;
+        std::sort(latency.begin(), latency.end());
+        const auto p50 = latency[latency.size() / 2],
+                   p99 = latency[latency.size() * 99 / 100];
+        std::cout << (pause ? "pause " : "cancel") << " -> zero speed: "
+                  << "p50 = " << p50.count() << " us, "
+                  << "p99 = " << p99.count() << " us, "
+                  << "max = " << latency.back().count() << " us" << std::endl;
+        failed |= p50 > bound;
+    }
+    
+    // 路径跟随不占用动作锁，暂停须单独停车并停止推进；
+    // 模拟底盘的位置不变，路径终点永远到不了
+    {
+        const auto wait_for = [&](bool moving) {
+            const auto begin = clock_type::now();
+            while (emulator.moving != moving && clock_type::now() - begin < seconds(1))
+                std::this_thread::sleep_for(milliseconds(1));
+            return emulator.moving == moving;
+        };
+        const auto check = [&](bool condition, const char *what) {
+            std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+            failed |= !condition;
+        };
+        
+        const native::waypoint_t points[]{{0, 0}, {100, 0}};
+        native::follow_path(points, 2, 0.2, 0.5);
+        check(wait_for(true), "path following starts");
+        
+        native::set_paused(true);
+        check(wait_for(false), "pause stops path following");
+        const auto frames = emulator.moving_frames.load();
+        std::this_thread::sleep_for(milliseconds(200));
+        check(emulator.moving_frames == frames, "no moving frame while paused");
+        
+        native::set_paused(false);
+        check(wait_for(true), "path following resumes");
+        
+        native::cancel_action();
+        check(wait_for(false), "cancel stops path following");
+        native::path_stats_t stats{};
+        native::get_path_stats(stats);
+        check(!stats.active, "path cleared by cancel");
+    }
+    
+    native::shutdown();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <utilities/raii/exception_engine.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * 错误管理器测试
+ *
+ * 检查槽被覆盖后查询旧序列号报告“已丢失”而不是成功，
+ * 再以一个写线程持续绕环写入、一个读线程读取并核对信息是否属于所查询的序列号；
+ * 任何一项不符时以非零值退出
+ */
+int main() {
+    enum class code_t : unsigned { none, lost, failed };
+    constexpr static auto size = 128u;
+    
+    auto failed = false;
+    auto check  = [&](bool condition, const char *what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        failed |= !condition;
+    };
+    
+    {
+        autolabor::exception_engine<unsigned, code_t, size> engine(code_t::lost, "lost");
+        engine.set(5, code_t::failed, "five");
+        check(engine.code(5) == code_t::failed && std::string(engine[5]) == "five", "read own error");
+        check(engine.code(6) == code_t::none && !*engine[6], "success reports none");
+        engine.set(5 + size, code_t::failed, "next");
+        check(engine.code(5) == code_t::lost && std::string(engine[5]) == "lost", "overwritten error reports lost");
+        check(engine.code(5 + size) == code_t::failed, "overwriting error kept");
+        check(engine.code(5 + 2 * size) == code_t::none, "later success in same slot reports none");
+        engine.remove(5 + size);
+        engine.set(5 + 3 * size, code_t::failed, "later");
+        check(engine.code(5 + size) == code_t::none, "removed error is not lost");
+    }
+    
+    {
+        autolabor::exception_engine<unsigned, code_t, size> engine(code_t::lost, "lost");
+        
+        std::atomic<bool>     running{true};
+        std::atomic<unsigned> last{0};
+        
+        const auto text = [](unsigned id) {
+            char buffer[300];
+            std::snprintf(buffer, sizeof(buffer), "%u:%s", id, std::string(200 + id % 50, 'a' + id % 26).c_str());
+            return std::string(buffer);
+        };
+        std::thread writer([&] {
+            for (unsigned id = 1; running; ++id) {
+                engine.set_detail(id, code_t::failed, text(id).c_str());
+                last = id;
+            }
+        });
+        size_t reads = 0, torn = 0;
+        for (auto i = 0; i < 1000000; ++i) {
+            const auto id      = last.load();
+            const auto message = std::string(engine[id]);
+            if (message.empty() || message == "lost") continue;
+            ++reads;
+            if (message != text(id)) ++torn;
+        }
+        running = false;
+        writer.join();
+        std::cout << reads << " reads, " << torn << " torn" << std::endl;
+        check(reads > 0 && !torn, "messages stay intact while the ring wraps");
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <internal/jerk_profile_t.hh>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using autolabor::jerk_profile_t;
+
+/**
+ * S 形速度曲线测试
+ *
+ * 按距离和按时间各构造三种峰值情形：巡航到最大速度、只达到最大加速度、连最大加速度都达不到，
+ * 检查闭式的总距离和总时间，并逐步数值微分核对速度、加速度和约束；
+ * 任何一项不符时以非零值退出
+ */
+int main() {
+    constexpr static auto speed        = 1.0,
+                          acceleration = 0.5,
+                          jerk         = 1.0,
+                          step         = 1e-4,
+                          epsilon      = 1e-6;
+    
+    auto failed = false;
+    auto check  = [&](bool condition, const std::string &what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        failed |= !condition;
+    };
+    
+    // 沿曲线逐步检查：位移的导数是速度，速度和加速度不越界，首尾静止
+    const auto check_shape = [&](const jerk_profile_t &profile, const std::string &name) {
+        auto consistent = true,
+             bounded    = true;
+        for (auto t = step; t < profile.duration(); t += step) {
+            const auto v = profile.speed(t),
+                       a = (profile.speed(t + step / 2) - profile.speed(t - step / 2)) / step,
+                       d = (profile.position(t + step / 2) - profile.position(t - step / 2)) / step;
+            consistent &= std::abs(d - v) < 1e-4;
+            bounded &= v <= speed + epsilon && v >= -epsilon && std::abs(a) <= acceleration + 1e-3;
+        }
+        check(consistent, name + ": position integrates speed");
+        check(bounded, name + ": speed and acceleration within limits");
+        check(std::abs(profile.speed(0)) < epsilon && std::abs(profile.speed(profile.duration())) < epsilon,
+              name + ": starts and ends at rest");
+        check(std::abs(profile.position(profile.duration()) - profile.distance()) < epsilon,
+              name + ": ends at the total distance");
+    };
+    
+    // 最大速度 1 需要 3 的加速距离（v (v/a + a/j)），加速度达到上限的临界峰值速度为 a²/j = 0.25
+    struct case_t {
+        const char *name;
+        double      distance, peak;
+    };
+    for (const auto &c : {case_t{"distance, cruise", 5, 1},
+                          case_t{"distance, acceleration limited", 1, (std::sqrt(0.0625 + 2) - 0.25) / 2},
+                          case_t{"distance, jerk limited", 0.2, std::cbrt(0.2 * 0.2 * jerk / 4)}}) {
+        const auto profile = jerk_profile_t::of_distance(c.distance, speed, acceleration, jerk);
+        check(std::abs(profile.distance() - c.distance) < epsilon, std::string(c.name) + ": distance");
+        check(std::abs(profile.peak() - c.peak) < epsilon, std::string(c.name) + ": peak speed");
+        check_shape(profile, c.name);
+    }
+    
+    // 最大速度 1 需要 2.5 的加速时间（v/a + a/j），加速度达到上限的临界半程时间为 2a/j = 1
+    struct timed_t {
+        const char *name;
+        double      duration, peak;
+    };
+    for (const auto &c : {timed_t{"duration, cruise", 8, 1},
+                          timed_t{"duration, acceleration limited", 3, acceleration * (1.5 - acceleration / jerk)},
+                          timed_t{"duration, jerk limited", 1.6, jerk * 0.8 * 0.8 / 4}}) {
+        const auto profile = jerk_profile_t::of_duration(c.duration, speed, acceleration, jerk);
+        check(std::abs(profile.duration() - c.duration) < epsilon, std::string(c.name) + ": duration");
+        check(std::abs(profile.peak() - c.peak) < epsilon, std::string(c.name) + ": peak speed");
+        check_shape(profile, c.name);
+    }
+    
+    return failed ? 1 : 0;
+}
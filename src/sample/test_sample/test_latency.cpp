@@ -0,0 +1,69 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <pm1_sdk_native.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * 接口延迟测试
+ *
+ * 同一份代码分别链接 pm1_sdk_native（进程内）和 pm1_sdk_client（经由 pm1d），
+ * 比较单次调用往返延迟、调用吞吐量和订阅推送速率
+ */
+int main(int argc, char **argv) {
+    using namespace autolabor::pm1;
+    using namespace std::chrono;
+    
+    double progress;
+    auto   handler = native::initialize(argc > 1 ? argv[1] : "", progress);
+    if (native::get_error_code(handler)) {
+        std::cerr << native::get_error_info(handler) << std::endl;
+        return 1;
+    }
+    
+    // 往返延迟
+    constexpr static size_t times = 20000;
+    std::vector<double>     latency(times);
+    double                  stamp, s, a, x, y, theta;
+    for (auto &item : latency) {
+        const auto t0 = steady_clock::now();
+        native::get_odometry(stamp, s, a, x, y, theta);
+        item = duration<double, std::micro>(steady_clock::now() - t0).count();
+    }
+    std::sort(latency.begin(), latency.end());
+    std::cout << "get_odometry round trip: "
+              << "p50 = " << latency[times / 2] << " us, "
+              << "p99 = " << latency[times * 99 / 100] << " us" << std::endl;
+    
+    // 调用吞吐量
+    size_t     calls = 0;
+    const auto end   = steady_clock::now() + seconds(1);
+    native::telemetry_t telemetry{};
+    while (steady_clock::now() < end) {
+        native::get_telemetry(telemetry);
+        ++calls;
+    }
+    std::cout << "get_telemetry: " << calls << " calls/s" << std::endl;
+    
+    // 订阅推送
+    std::atomic<size_t> frames{0};
+    unsigned int        subscription;
+    native::subscribe(0xffffffff, 1,
+                      [](const native::telemetry_t *, unsigned int, void *user) {
+                          ++*static_cast<std::atomic<size_t> *>(user);
+                      },
+                      &frames, subscription);
+    std::this_thread::sleep_for(seconds(2));
+    native::unsubscribe(subscription);
+    std::cout << "subscription: " << frames / 2.0 << " frames/s" << std::endl;
+    
+    native::shutdown();
+    return 0;
+}
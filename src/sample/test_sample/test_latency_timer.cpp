@@ -0,0 +1,52 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <utilities/serial_port/serial.h>
+#include <utilities/serial_port/serial_test.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <sys/stat.h>
+
+/**
+ * 接收延迟定时器读写测试
+ *
+ * 在临时目录中伪造 sysfs：ttyUSB0 是带 latency_timer 的 FTDI 适配器，ttyACM0 没有定时器，
+ * 检查读、写、恢复和不支持时的返回值
+ */
+int main() {
+    char root[] = "/tmp/pm1_sysfs_XXXXXX";
+    if (!mkdtemp(root)) return 1;
+    
+    const auto base = std::string(root);
+    for (const auto &dir : {"/class", "/class/tty",
+                            "/class/tty/ttyUSB0", "/class/tty/ttyUSB0/device",
+                            "/class/tty/ttyACM0", "/class/tty/ttyACM0/device"})
+        mkdir((base + dir).c_str(), 0755);
+    std::ofstream(base + "/class/tty/ttyUSB0/device/latency_timer") << 16 << std::endl;
+    
+    serial::set_sysfs_root(base);
+    
+    auto failed = 0;
+    const auto check = [&failed](bool condition, const char *what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        if (!condition) ++failed;
+    };
+    
+    check(serial::get_latency_timer("/dev/ttyUSB0") == 16, "read driver default");
+    check(serial::set_latency_timer("/dev/ttyUSB0", 1), "tune to 1 ms");
+    check(serial::get_latency_timer("/dev/ttyUSB0") == 1, "read back tuned value");
+    check(serial::set_latency_timer("/dev/ttyUSB0", 16), "restore");
+    check(serial::get_latency_timer("/dev/ttyUSB0") == 16, "read back restored value");
+    check(serial::get_latency_timer("/dev/ttyACM0") == -1, "adapter without timer");
+    check(!serial::set_latency_timer("/dev/ttyACM0", 1), "no timer to tune");
+    check(!serial::set_latency_timer("/dev/ttyS0", 1), "port missing from sysfs");
+    
+    std::filesystem::remove_all(base);
+    return failed;
+}
@@ -0,0 +1,102 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <internal/pm1_odometry_t.hh>
+
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace autolabor::pm1;
+using autolabor::now;
+
+/**
+ * 延迟推算里程计测试
+ *
+ * 同一串两轮应答分别送入即时模式和延迟模式的里程计，
+ * 检查任意时刻读到的位姿完全相同，包括延迟模式下增量环写满、由读线程推算的情形；
+ * 再让编码器读数跨过 32 位回绕，检查位姿与不回绕的读数一致；
+ * 任何一项不符时以非零值退出
+ */
+int main() {
+    using namespace std::chrono_literals;
+    
+    // 询问帧写入伪终端，主端非阻塞地读出丢弃
+    const auto master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master < 0 || grantpt(master) || unlockpt(master)) return 1;
+    serial_port port(ptsname(master), 115200);
+    const auto  drain = [master] {
+        uint8_t buffer[256];
+        while (read(master, buffer, sizeof buffer) > 0);
+    };
+    
+    auto failed = false;
+    auto check  = [&](bool condition, const std::string &what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        failed |= !condition;
+    };
+    
+    // 两个里程计各自完成一轮询问和应答，左轮先应答
+    const auto feed = [&](pm1_odometry_t &odometry, decltype(now()) time, int32_t left, int32_t right) {
+        odometry.ask(port);
+        odometry.try_parse(time, pack_value<ecu<0>::current_position_rx, int32_t>(left), default_config);
+        odometry.try_parse(time + 2ms, pack_value<ecu<1>::current_position_rx, int32_t>(right), default_config);
+        drain();
+    };
+    const auto same = [](const autolabor::odometry_t<> &a, const autolabor::odometry_t<> &b) {
+        return a.s == b.s && a.a == b.a && a.x == b.x && a.y == b.y && a.theta == b.theta;
+    };
+    
+    {
+        pm1_odometry_t eager, lazy;
+        lazy.set_lazy(true);
+        
+        const auto origin = now();
+        int32_t    left   = 0,
+                   right  = 0;
+        auto       equal  = true;
+        for (auto i = 0; i < 1000; ++i) {
+            left += 900 + i % 37 * 20;
+            right += 1100 - i % 23 * 15;
+            const auto time = origin + i * 50ms;
+            feed(eager, time, left, right);
+            feed(lazy, time, left, right);
+            // 前 600 轮之间很少读取，增量环多次写满
+            if (i < 600 ? i % 300 == 299 : i % 7 == 0)
+                equal &= same(eager.value().value, lazy.value().value);
+        }
+        check(equal, "lazy pose equals eager pose");
+        check(eager.value().time == lazy.value().time, "lazy stamp equals eager stamp");
+        check(std::abs(eager.value().value.x) > 1, "chassis actually moved");
+    }
+    {
+        pm1_odometry_t plain, wrapped;
+        
+        const auto origin = now();
+        int64_t    left   = 0,
+                   right  = 0;
+        const auto offset = static_cast<int64_t>(INT32_MAX) - 20000;
+        for (auto i = 0; i < 100; ++i) {
+            left += 1000;
+            right -= 1000;
+            const auto time = origin + i * 50ms;
+            feed(plain, time, static_cast<int32_t>(left), static_cast<int32_t>(right));
+            // 左轮向上越过 INT32_MAX，右轮从 INT32_MIN 附近向下越过
+            feed(wrapped, time,
+                 static_cast<int32_t>(static_cast<uint32_t>(offset + left)),
+                 static_cast<int32_t>(static_cast<uint32_t>(-offset - 1 + right)));
+        }
+        check(same(plain.value().value, wrapped.value().value), "pose unaffected by int32 wrap");
+        check(plain.value().value.a > 1, "chassis actually turned");
+    }
+    
+    close(master);
+    return failed ? 1 : 0;
+}
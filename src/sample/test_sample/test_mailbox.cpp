@@ -0,0 +1,76 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <utilities/mailbox_t.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * 信箱竞争测试
+ *
+ * 多个写线程以全速写入各字段相同的值，一个读线程持续读取，
+ * 检查读到的值是否完整、版本是否单调，统计读写次数；
+ * 出现撕裂或版本回退时以非零值退出
+ */
+int main() {
+    using namespace std::chrono;
+    using namespace std::chrono_literals;
+    
+    struct value_t {
+        double a, b, c;
+    };
+    
+    constexpr static auto period = 1s;
+    
+    auto failed = false;
+    for (size_t writers : {1, 2, 4, 8}) {
+        mailbox_t<value_t> mailbox;
+        
+        std::atomic<bool>   running{true};
+        std::atomic<size_t> writes{0};
+        size_t              reads   = 0,
+                            torn    = 0,
+                            regress = 0;
+        
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < writers; ++i)
+            threads.emplace_back([&, i] {
+                size_t local = 0;
+                while (running) {
+                    const auto x = static_cast<double>(i << 32u | ++local);
+                    mailbox.write({x, -x, x * 2});
+                }
+                writes += local;
+            });
+        threads.emplace_back([&] {
+            uint64_t last = 0;
+            value_t  value{};
+            while (running) {
+                const auto version = mailbox.read(value);
+                if (!version) continue;
+                ++reads;
+                if (value.b != -value.a || value.c != value.a * 2) ++torn;
+                if (version < last) ++regress;
+                last = version;
+            }
+        });
+        
+        std::this_thread::sleep_for(period);
+        running = false;
+        for (auto &thread : threads) thread.join();
+        
+        const auto seconds = duration_cast<duration<double>>(period).count();
+        std::cout << writers << " writers: "
+                  << writes / seconds << " writes/s, "
+                  << reads / seconds << " reads/s, "
+                  << torn << " torn, "
+                  << regress << " regressions" << std::endl;
+        failed |= torn || regress;
+    }
+    return failed ? 1 : 0;
+}
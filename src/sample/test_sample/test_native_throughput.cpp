@@ -0,0 +1,88 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <pm1_sdk.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+    thread_local size_t allocations = 0;
+}
+
+void *operator new(size_t size) {
+    ++allocations;
+    if (auto p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+/**
+ * 接口吞吐量测试
+ *
+ * 1~16 个线程同时调用同一接口，统计每秒调用数、失败数与堆分配次数
+ *
+ * @param name  接口名
+ * @param block 一次调用，返回是否成功
+ */
+template<class f_t>
+void measure(const char *name, f_t &&block) {
+    using namespace std::chrono_literals;
+    
+    for (size_t n : {1, 2, 4, 8, 16}) {
+        std::atomic<bool>   running{true};
+        std::atomic<size_t> calls{0},
+                            failures{0},
+                            heap{0};
+        
+        std::vector<std::thread> threads;
+        threads.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            threads.emplace_back([&] {
+                size_t     local_calls    = 0,
+                           local_failures = 0;
+                const auto before         = allocations;
+                while (running) {
+                    if (!block()) ++local_failures;
+                    ++local_calls;
+                }
+                calls += local_calls;
+                failures += local_failures;
+                heap += allocations - before;
+            });
+        std::this_thread::sleep_for(1s);
+        running = false;
+        for (auto &thread : threads) thread.join();
+        
+        std::cout << name << " x " << n << ": "
+                  << calls << " calls/s, "
+                  << failures << " failures, "
+                  << heap << " allocations" << std::endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    using namespace autolabor::pm1;
+    
+    auto connection = initialize(argc > 1 ? argv[1] : "");
+    if (!connection) {
+        std::cerr << connection.error_info << std::endl;
+        return 1;
+    }
+    
+    measure("get_odometry", [] { return static_cast<bool>(get_odometry()); });
+    // 多线程同时控制时，竞争失败的调用返回 action conflict
+    measure("drive_velocity", [] { return static_cast<bool>(drive_velocity(0, 0)); });
+    
+    shutdown();
+    return 0;
+}
@@ -0,0 +1,103 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <internal/path_follower_t.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace autolabor;
+using namespace autolabor::pm1;
+
+/**
+ * 纯追踪路径跟随运动学测试
+ *
+ * 以运动模型积分位姿代替底盘，后轮转角限幅模拟转向能力，
+ * 分别检查直线、弯道、偏离路径起步和横向冲过终点时能否按时结束、
+ * 结束时到终点的距离和横向误差统计；任何一项不符时以非零值退出
+ */
+int main() {
+    constexpr static auto dt         = 0.02,
+                          max_rudder = 0.6,
+                          tolerance  = 0.02;
+    
+    auto failed = false;
+    auto check  = [&](bool condition, const char *what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        failed |= !condition;
+    };
+    
+    // 从 pose 起步跟随 points，返回结束用时，超过 limit 仍未结束时返回 NAN
+    const auto run = [](path_follower_t &follower,
+                        const std::vector<path_follower_t::point_t> &points,
+                        odometry_t<> pose,
+                        double limit) -> double {
+        follower.start(points.data(), points.size(), 0.5, 0.4);
+        for (auto t = .0; t < limit; t += dt) {
+            physical target{};
+            if (!follower.step(pose, default_config, target)) return t;
+            if (target.speed == 0) continue;
+            target.rudder = std::max<float>(-max_rudder, std::min<float>(max_rudder, target.rudder));
+            const auto v = physical_to_velocity(target, &default_config);
+            // 中点积分
+            const auto theta = pose.theta + v.w * dt / 2;
+            pose.x += v.v * std::cos(theta) * dt;
+            pose.y += v.v * std::sin(theta) * dt;
+            pose.theta += v.w * dt;
+        }
+        return NAN;
+    };
+    
+    {
+        path_follower_t follower;
+        const auto      time  = run(follower, {{0, 0}, {3, 0}}, {0, 0, 0, 0, 0}, 20);
+        const auto      stats = follower.stats();
+        check(!std::isnan(time) && time < 8, "straight path finishes");
+        check(stats.residual <= tolerance, "straight path stops at the goal");
+        check(stats.count > 0 && stats.max < 1e-6, "straight path has no lateral error");
+        check(!stats.active && stats.waypoints == 1, "goal kept as the next start");
+    }
+    {
+        // 半径 2 m 的四分之一圆弧
+        std::vector<path_follower_t::point_t> arc;
+        for (auto i = 0; i <= 20; ++i) {
+            const auto a = M_PI / 2 * i / 20;
+            arc.push_back({2 * std::sin(a), 2 - 2 * std::cos(a)});
+        }
+        path_follower_t follower;
+        const auto      time  = run(follower, arc, {0, 0, 0, 0, 0}, 30);
+        const auto      stats = follower.stats();
+        check(!std::isnan(time) && time < 10, "curved path finishes");
+        check(stats.residual <= tolerance, "curved path stops at the goal");
+        check(stats.rms < 0.03 && stats.max < 0.05, "curved path stays close");
+    }
+    {
+        path_follower_t follower;
+        const auto      time  = run(follower, {{0, 0}, {4, 0}}, {0, 0, 0, 0.5, 0}, 30);
+        const auto      stats = follower.stats();
+        check(!std::isnan(time) && time < 12, "off-path start finishes");
+        check(stats.residual <= tolerance, "off-path start stops at the goal");
+        check(std::abs(stats.max - 0.5) < 1e-6, "initial offset counted as max");
+        check(std::abs(stats.last) < tolerance, "converges onto the path");
+    }
+    {
+        // 终点就在侧前方，转向能力不足以直接到达，横向冲过终点后应结束而不是绕圈
+        path_follower_t follower;
+        const auto      time  = run(follower, {{0, 0}, {1, 0}}, {0, 0, 0.9, 0.3, 0}, 30);
+        const auto      stats = follower.stats();
+        check(!std::isnan(time) && time < 2, "overshoot finishes instead of orbiting");
+        check(stats.residual > tolerance && stats.residual < 0.5, "overshoot reports the residual");
+        check(!stats.active && stats.waypoints == 1, "overshoot keeps the goal");
+    }
+    {
+        path_follower_t follower;
+        const path_follower_t::point_t points[]{{0, 0}, {1, 0}};
+        follower.start(points, 2, 0.5, 0.4);
+        check(std::isnan(follower.stats().residual), "no residual before finishing");
+    }
+    
+    return failed ? 1 : 0;
+}
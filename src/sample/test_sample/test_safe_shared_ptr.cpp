@@ -0,0 +1,83 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <utilities/raii/safe_shared_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * 指针竞争测试
+ *
+ * 多个读线程持续读取，同时一个写线程每 10ms 替换一次指针，
+ * 统计读取次数与失败次数；
+ * 另检查在读操作内部替换指针时抛出异常而不是死锁，不符时以非零值退出
+ */
+int main() {
+    using namespace std::chrono;
+    using namespace std::chrono_literals;
+    
+    constexpr static auto period = 1s;
+    
+    auto nested = false;
+    {
+        safe_shared_ptr<size_t> ptr;
+        ptr(std::make_shared<size_t>(0));
+        try {
+            ptr.read([&](size_t *) { return ptr(nullptr); });
+        } catch (std::logic_error &) {
+            nested = true;
+        }
+        std::cout << "replace inside read: " << (nested ? "rejected" : "NOT rejected") << std::endl;
+    }
+    
+    for (size_t readers : {1, 2, 4, 8, 16}) {
+        safe_shared_ptr<size_t> ptr;
+        ptr(std::make_shared<size_t>(0));
+        
+        std::atomic<bool>   running{true};
+        std::atomic<size_t> reads{0},
+                            failures{0},
+                            replaces{0};
+        
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < readers; ++i)
+            threads.emplace_back([&] {
+                size_t local_reads    = 0,
+                       local_failures = 0,
+                       sum            = 0;
+                while (running) {
+                    try {
+                        sum += ptr.read([](size_t *p) { return *p; });
+                        ++local_reads;
+                    } catch (std::exception &) {
+                        ++local_failures;
+                    }
+                }
+                reads += local_reads;
+                failures += local_failures;
+            });
+        threads.emplace_back([&] {
+            size_t value = 0;
+            while (running) {
+                ptr(std::make_shared<size_t>(++value));
+                ++replaces;
+                std::this_thread::sleep_for(10ms);
+            }
+        });
+        
+        std::this_thread::sleep_for(period);
+        running = false;
+        for (auto &thread : threads) thread.join();
+        
+        std::cout << readers << " readers: "
+                  << reads / duration_cast<duration<double>>(period).count() << " reads/s, "
+                  << failures << " failures, "
+                  << replaces << " replaces" << std::endl;
+    }
+    return nested ? 0 : 1;
+}
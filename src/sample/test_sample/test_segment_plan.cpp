@@ -0,0 +1,86 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <internal/segment_plan_t.hh>
+
+#include <cmath>
+#include <iostream>
+
+using namespace autolabor::pm1;
+
+/**
+ * 连续运动段速度规划测试
+ *
+ * 检查段间停车与平滑衔接的判定、衔接速度的折减，
+ * 以及各段起点、终点的速度上限是否满足起步、加速和减速约束；
+ * 任何一项不符时以非零值退出
+ */
+int main() {
+    constexpr static auto width        = 0.5,  // 转角优化宽度
+                          rudder_speed = 1.0,
+                          epsilon      = 1e-6;
+    
+    const autolabor::process_controller controller{0.1, 0.05, 0.5, 0.4};
+    
+    auto failed = false;
+    auto check  = [&](bool condition, const char *what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        failed |= !condition;
+    };
+    const auto near = [](double a, double b) { return std::abs(a - b) < epsilon; };
+    
+    {
+        const segment_plan_t plan({{{1, 0}, 4}}, controller, width, rudder_speed);
+        check(plan.size() == 1 && near(plan.length(), 4) && near(plan.begin(1), 4), "single segment length");
+        check(plan.stop_before(0), "start from rest");
+        check(near(plan.speed(0, 0, 0), controller.speed_begin), "start at speed_begin");
+        check(near(plan.speed(0, 1, 0), 0.6), "accelerate from the start");
+        check(near(plan.speed(0, 3, 0), 0.45), "decelerate towards the goal");
+        check(near(plan.speed(0, 4, 0), controller.speed_end), "stop at speed_end");
+        check(near(plan.speed(0, 3, 2.9), controller.speed_begin + 0.05), "restart after pause");
+    }
+    {
+        // 同向同转角：不停车，衔接速度取两段较慢者
+        const segment_plan_t plan({{{1, 0}, 4}, {{0.6, 0}, 4}}, controller, width, rudder_speed);
+        check(!plan.stop_before(1), "same rudder blends");
+        check(near(plan.speed(0, 4, 0), 0.6), "exit capped by the slower segment");
+        check(near(plan.speed(1, 4, 0), 0.6), "entry equals exit");
+        check(near(plan.speed(1, 8, 0), controller.speed_end), "stop only at the last goal");
+    }
+    {
+        // 转角变化在优化宽度内：衔接速度按转角变化折减，并受后轮转动期间的里程约束
+        const segment_plan_t plan({{{1, 0}, 4}, {{1, 0.25f}, 4}}, controller, width, rudder_speed);
+        const auto joint = std::min(1 * (1 - 0.25 / width), 4 / 4 / (0.25 / rudder_speed));
+        check(!plan.stop_before(1), "small rudder change blends");
+        check(near(plan.speed(0, 4, 0), joint), "joint speed scaled by rudder change");
+        
+        const segment_plan_t slow({{{1, 0}, 0.2}, {{1, 0.25f}, 4}}, controller, width, rudder_speed);
+        check(slow.speed(1, 0.2, 0) <= 0.2 / 4 / (0.25 / rudder_speed) + epsilon, "joint limited by rudder slew");
+    }
+    {
+        // 转角变化超过优化宽度或换向：段间停车
+        const segment_plan_t turn({{{1, 0}, 4}, {{1, 0.6f}, 4}}, controller, width, rudder_speed);
+        check(turn.stop_before(1), "large rudder change stops");
+        check(near(turn.speed(0, 4, 0), controller.speed_end), "stop at the joint");
+        check(near(turn.speed(1, 4, 4), controller.speed_begin), "restart at the joint");
+        
+        const segment_plan_t reverse({{{1, 0}, 4}, {{-1, 0}, 4}}, controller, width, rudder_speed);
+        check(reverse.stop_before(1), "reversing stops");
+    }
+    {
+        // 短段：后向约束保证来得及在终点停车，前向约束保证衔接速度能够达到
+        const segment_plan_t plan({{{1, 0}, 0.5}, {{1, 0}, 0.5}, {{1, 0}, 0.5}}, controller, width, rudder_speed);
+        auto bounded = true;
+        for (size_t i = 0; i < plan.size(); ++i)
+            for (auto x = plan.begin(i); x <= plan.begin(i + 1) + epsilon; x += 0.01) {
+                const auto speed = plan.speed(i, x, 0);
+                bounded &= speed <= controller.speed_begin + controller.acceleration * x + epsilon;
+                bounded &= speed <= controller.speed_end + controller.deceleration * (plan.length() - x) + epsilon;
+            }
+        check(bounded, "acceleration and deceleration limits hold over short segments");
+        check(near(plan.speed(0, 0.5, 0), plan.speed(1, 0.5, 0)), "speed continuous across a joint");
+    }
+    
+    return failed ? 1 : 0;
+}
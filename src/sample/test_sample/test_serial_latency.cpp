@@ -0,0 +1,86 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <utilities/serial_port/serial_port.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * 串口接收延迟测试
+ *
+ * 在伪终端上模拟 115200 波特率的底盘：逐字节写入 14 字节的帧，
+ * 字节间隔 87 微秒，帧间隔 5 毫秒；
+ * 分别以普通模式和低延迟模式打开另一端，
+ * 统计帧的最后一个字节写出到读线程拿到整帧的延迟，以及每帧唤醒读线程的次数
+ */
+int main() {
+    using namespace std::chrono;
+    
+    constexpr static size_t
+        frame_size = 14,
+        frames     = 400;
+    constexpr static auto
+        byte_interval  = microseconds(87),
+        frame_interval = microseconds(5000);
+    
+    for (const auto baud_rate : {115200u, 250000u})
+        for (const auto low_latency : {false, true}) {
+            const auto master = posix_openpt(O_RDWR | O_NOCTTY);
+            grantpt(master);
+            unlockpt(master);
+            
+            serial_port port(ptsname(master), baud_rate, 20, 1, 0x100, 0x100,
+                             low_latency ? frame_size : 0);
+            
+            std::vector<steady_clock::time_point> sent(frames);
+            std::atomic_bool                      done{false};
+            std::thread writer([&] {
+                uint8_t frame[frame_size]{};
+                for (auto &stamp : sent) {
+                    std::this_thread::sleep_for(frame_interval);
+                    for (size_t i = 0; i < frame_size; ++i) {
+                        if (i) std::this_thread::sleep_for(byte_interval);
+                        if (i == frame_size - 1) stamp = steady_clock::now();
+                        write(master, frame + i, 1);
+                    }
+                }
+                std::this_thread::sleep_for(milliseconds(200));
+                done = true;
+                port.break_read();
+            });
+            
+            std::vector<double> latency;
+            size_t              received = 0, reads = 0;
+            uint8_t             buffer[0x100];
+            while (!done && latency.size() < frames) {
+                const auto actual = port.read(buffer, sizeof(buffer));
+                if (!actual) continue;
+                ++reads;
+                const auto now = steady_clock::now();
+                // 本次读取补齐了若干帧
+                for (received += actual; received >= (latency.size() + 1) * frame_size;)
+                    latency.push_back(duration<double, std::micro>(now - sent[latency.size()]).count());
+            }
+            writer.join();
+            close(master);
+            
+            std::sort(latency.begin(), latency.end());
+            std::cout << baud_rate << (low_latency ? " low latency" : " normal     ")
+                      << " | frames: " << latency.size()
+                      << " | reads/frame: " << static_cast<double>(reads) / latency.size()
+                      << " | latency p50: " << latency[latency.size() / 2]
+                      << " us, p99: " << latency[latency.size() * 99 / 100]
+                      << " us" << std::endl;
+        }
+    return 0;
+}
@@ -0,0 +1,89 @@
+﻿//
+// Created by User on 2026/10/18.
+//
+
+#include <internal/pm1_odometry_t.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace autolabor::pm1;
+using autolabor::now;
+
+/**
+ * 两轮插值配对测试
+ *
+ * 两轮按已知的连续轨迹转动，右轮应答比左轮晚 2~20 毫秒且抖动；
+ * 以两轮同时采样的读数推算的位姿为基准，
+ * 检查插值配对的位姿误差远小于直接配对，且绝对误差足够小；
+ * 任何一项不符时以非零值退出
+ */
+int main() {
+    using namespace std::chrono;
+    
+    // 询问帧写入伪终端，主端非阻塞地读出丢弃
+    const auto master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master < 0 || grantpt(master) || unlockpt(master)) return 1;
+    serial_port port(ptsname(master), 115200);
+    
+    auto failed = false;
+    auto check  = [&](bool condition, const std::string &what) {
+        std::cout << (condition ? "pass: " : "FAIL: ") << what << std::endl;
+        failed |= !condition;
+    };
+    
+    // 两轮位置（脉冲），速度缓慢变化，轨迹是一条曲率变化的曲线；
+    // 前两轮静止，使第一次读数（里程零点）与采样时刻无关
+    const auto left  = [](double t) {
+        t = std::max(.0, t - 0.1);
+        return static_cast<int32_t>(std::lround(20000 * t + 3000 * std::sin(t)));
+    };
+    const auto right = [](double t) {
+        t = std::max(.0, t - 0.1);
+        return static_cast<int32_t>(std::lround(22000 * t - 4000 * std::sin(0.7 * t)));
+    };
+    
+    pm1_odometry_t reference, direct, interpolated;
+    interpolated.set_interpolate(true);
+    
+    const auto origin = now();
+    const auto at     = [origin](double t) { return origin + duration_cast<nanoseconds>(duration<double>(t)); };
+    for (auto i = 0; i < 1000; ++i) {
+        const auto t    = i * 0.05,
+                   skew = 0.002 + 0.018 * (i * 7919 % 100) / 100.0;
+        
+        reference.ask(port);
+        reference.try_parse(at(t), pack_value<ecu<0>::current_position_rx, int32_t>(left(t)), default_config);
+        reference.try_parse(at(t), pack_value<ecu<1>::current_position_rx, int32_t>(right(t)), default_config);
+        for (auto *odometry : {&direct, &interpolated}) {
+            odometry->ask(port);
+            odometry->try_parse(at(t), pack_value<ecu<0>::current_position_rx, int32_t>(left(t)), default_config);
+            odometry->try_parse(at(t + skew), pack_value<ecu<1>::current_position_rx, int32_t>(right(t + skew)), default_config);
+        }
+        
+        uint8_t buffer[256];
+        while (read(master, buffer, sizeof buffer) > 0);
+    }
+    
+    const auto error = [&](const pm1_odometry_t &odometry) {
+        const auto a = reference.value().value,
+                   b = odometry.value().value;
+        return std::hypot(a.x - b.x, a.y - b.y) + std::abs(a.theta - b.theta);
+    };
+    const auto e_direct       = error(direct),
+               e_interpolated = error(interpolated);
+    std::cout << "pose error: direct = " << e_direct << ", interpolated = " << e_interpolated << std::endl;
+    
+    check(e_interpolated * 10 < e_direct, "interpolation removes most of the skew error");
+    check(e_interpolated < 1e-3, "interpolated pose matches simultaneous sampling");
+    check(interpolated.value().time == reference.value().time, "pair stamped at the earlier reply");
+    
+    close(master);
+    return failed ? 1 : 0;
+}